@@ -0,0 +1,91 @@
+#include "APIWallPlacement.hpp"
+#include "MigrationUtils.hpp"
+
+static GSErrCode CreatePolygonWallElement (const API_Element& wallTemplate, const MG::WallPoint* points, size_t pointCount, API_Guid& placedWallGuid)
+{
+	API_Element wallElement = wallTemplate;
+	wallElement.wall.begC = { points[0].x, points[0].y };
+	wallElement.wall.endC = { points[pointCount - 1].x, points[pointCount - 1].y };
+	if (pointCount == 2) {
+		GSErrCode err = ACAPI_Element_Create (&wallElement, nullptr);
+		placedWallGuid = wallElement.header.guid;
+		return err;
+	}
+
+	std::vector<MG::WallPoint> outline = MG::GetWallPolylineOutline (points, pointCount, wallTemplate.wall.thickness);
+	wallElement.wall.type = APIWtyp_Poly;
+	wallElement.wall.poly.nCoords = (Int32) outline.size () + 1;
+	wallElement.wall.poly.nSubPolys = 1;
+	wallElement.wall.poly.nArcs = 0;
+
+	API_ElementMemo wallMemo = {};
+
+	wallMemo.coords = (API_Coord**) BMhAllClear ((wallElement.wall.poly.nCoords + 1) * sizeof (API_Coord));
+	for (size_t i = 0; i < outline.size (); i++) {
+		(*wallMemo.coords)[i + 1] = { outline[i].x, outline[i].y };
+	}
+	(*wallMemo.coords)[wallElement.wall.poly.nCoords] = (*wallMemo.coords)[1];
+
+	wallMemo.pends = (Int32**) BMhAllClear ((wallElement.wall.poly.nSubPolys + 1) * sizeof (Int32));
+	(*wallMemo.pends)[1] = wallElement.wall.poly.nCoords;
+
+	GSErrCode err = ACAPI_Element_Create (&wallElement, &wallMemo);
+	ACAPI_DisposeElemMemoHdls (&wallMemo);
+	placedWallGuid = wallElement.header.guid;
+	return err;
+}
+
+APIWallPlacementBackend::APIWallPlacementBackend (GS::Array<API_Guid>& placedElementGuids, USize reservedGuidCount) :
+	placedElementGuids (placedElementGuids),
+	reservedGuidCount (reservedGuidCount),
+	wallTemplate ()
+{
+
+}
+
+bool APIWallPlacementBackend::BeginPlacement (size_t wallCount)
+{
+	placedElementGuids.SetCapacity (placedElementGuids.GetSize () + (USize) wallCount + reservedGuidCount);
+
+	wallTemplate = {};
+	SetAPIElementType (wallTemplate, API_WallID);
+	GSErrCode err = ACAPI_Element_GetDefaults (&wallTemplate, nullptr);
+	if (err != NoError) {
+		return false;
+	}
+	wallTemplate.wall.referenceLineLocation = APIWallRefLine_Center;
+	return true;
+}
+
+size_t APIWallPlacementBackend::PlaceWalls (const MG::WallGeometry* walls, size_t wallCount)
+{
+	size_t placedWallCount = 0;
+	API_Element wallElement = {};
+	for (size_t i = 0; i < wallCount; i++) {
+		wallElement = wallTemplate;
+		wallElement.wall.begC = { walls[i].begX, walls[i].begY };
+		wallElement.wall.endC = { walls[i].endX, walls[i].endY };
+		GSErrCode err = ACAPI_Element_Create (&wallElement, nullptr);
+		if (err != NoError) {
+			continue;
+		}
+		placedElementGuids.Push (wallElement.header.guid);
+		placedWallCount += 1;
+	}
+	return placedWallCount;
+}
+
+size_t APIWallPlacementBackend::PlacePolylines (const MG::WallPolylines& polylines)
+{
+	size_t placedWallCount = 0;
+	for (size_t i = 0; i < polylines.GetPolylineCount (); i++) {
+		API_Guid placedWallGuid;
+		GSErrCode err = CreatePolygonWallElement (wallTemplate, polylines.GetPoints (i), polylines.GetPointCount (i), placedWallGuid);
+		if (err != NoError) {
+			continue;
+		}
+		placedElementGuids.Push (placedWallGuid);
+		placedWallCount += 1;
+	}
+	return placedWallCount;
+}
@@ -0,0 +1,23 @@
+#ifndef APIWALLPLACEMENT_HPP
+#define APIWALLPLACEMENT_HPP
+
+#include "ACAPinc.h"
+#include "WallPlacement.hpp"
+#include "WallPolylines.hpp"
+
+class APIWallPlacementBackend : public MG::WallPlacementBackend
+{
+public:
+	APIWallPlacementBackend (GS::Array<API_Guid>& placedElementGuids, USize reservedGuidCount);
+
+	virtual bool	BeginPlacement (size_t wallCount) override;
+	virtual size_t	PlaceWalls (const MG::WallGeometry* walls, size_t wallCount) override;
+	virtual size_t	PlacePolylines (const MG::WallPolylines& polylines) override;
+
+private:
+	GS::Array<API_Guid>&	placedElementGuids;
+	USize					reservedGuidCount;
+	API_Element				wallTemplate;
+};
+
+#endif
@@ -3,11 +3,16 @@
 
 #include "ResourceIds.hpp"
 #include "MazeGenerator.hpp"
+#include "PlacementPipeline.hpp"
+#include "MazeCache.hpp"
 #include "MazeSettings.hpp"
 #include "MazeSettingsDialog.hpp"
+#include "APIWallPlacement.hpp"
 
 #include "MigrationUtils.hpp"
 
+#include <chrono>
+
 static const GSResID AddOnInfoID			= ID_ADDON_INFO;
 	static const Int32 AddOnNameID			= 1;
 	static const Int32 AddOnDescriptionID	= 2;
@@ -17,42 +22,15 @@ static const short AddOnMenuID				= ID_ADDON_MENU;
 
 static const GSResID AddOnStringsID			= ID_ADDON_STRINGS;
 	static const Int32 UndoStringID			= 1;
+	static const Int32 ProgressStringID		= 2;
+	static const Int32 FailedWallsStringID	= 3;
+	static const Int32 ErrorStringID		= 4;
 
 static const Int32 PreferencesVersion		= 1;
+static const Int32 ProgressMaxValue			= 1000;
+static const size_t MergedWallChunkSize		= 256;
 
-static void GenerateMazeWallGeometries (int rowCount, int colCount, double cellSize, std::vector<MG::WallGeometry>& mazeWalls)
-{
-	MG::MazeGenerator generator (rowCount, colCount);
-	if (!generator.Generate ()) {
-		return;
-	}
-
-	const MG::Maze& maze = generator.GetMaze ();
-	mazeWalls = maze.GetWallGeometries (cellSize);
-}
-
-static GSErrCode CreateWallElement (double begX, double begY, double endX, double endY, API_Guid& placedWallGuid)
-{
-	GSErrCode err = NoError;
-
-	API_Element wallElement = {};
-	SetAPIElementType (wallElement, API_WallID);
-	err = ACAPI_Element_GetDefaults (&wallElement, nullptr);
-	if (err != NoError) {
-		return err;
-	}
-
-	wallElement.wall.begC = { begX, begY };
-	wallElement.wall.endC = { endX, endY };
-	wallElement.wall.referenceLineLocation = APIWallRefLine_Center;
-	err = ACAPI_Element_Create (&wallElement, nullptr);
-	if (err != NoError) {
-		return err;
-	}
-
-	placedWallGuid = wallElement.header.guid;
-	return NoError;
-}
+static MG::MazeCache mazeCache;
 
 static GSErrCode CreateSlabElement (double begX, double begY, double endX, double endY, API_Guid& placedSlabGuid)
 {
@@ -90,6 +68,38 @@ static GSErrCode CreateSlabElement (double begX, double begY, double endX, doubl
 	return NoError;
 }
 
+static GSErrCode PlaceMazeWalls (const MazeSettings& mazeSettings, std::uint64_t seed, GS::Array<API_Guid>& placedElementGuids, size_t& failedWallCount)
+{
+	APIWallPlacementBackend placementBackend (placedElementGuids, mazeSettings.createSlab ? 1 : 0);
+	MG::PlacementPipeline placementPipeline (mazeSettings.rowCount, mazeSettings.columnCount, seed, mazeSettings.algorithm, mazeSettings.cellSize);
+	MG::CancellationToken cancellationToken;
+	if (mazeSettings.seed != 0) {
+		placementPipeline.SetMazeCache (&mazeCache);
+	}
+	if (mazeSettings.mergeWalls) {
+		placementPipeline.SetMergeWalls (true);
+		placementPipeline.SetChunkSize (MergedWallChunkSize);
+	}
+	placementPipeline.SetProgressCallback ([&] (const MG::PlacementProgress& progress) {
+		ProcessWindow_SetValue ((Int32) (progress.completedFraction * ProgressMaxValue));
+		if (ProcessWindow_IsCanceled ()) {
+			cancellationToken.Cancel ();
+		}
+	});
+
+	MG::PlacementResult placementResult = placementPipeline.Run (placementBackend, cancellationToken);
+	failedWallCount = placementResult.failedWallCount;
+	switch (placementResult.status) {
+	case MG::PlacementStatus::Completed:
+	case MG::PlacementStatus::PartiallyFailed:
+		return NoError;
+	case MG::PlacementStatus::Cancelled:
+		return APIERR_CANCEL;
+	default:
+		return APIERR_GENERAL;
+	}
+}
+
 static bool LoadMazeSettingsFromPreferences (MazeSettings& mazeSettings)
 {
 	GSErrCode err = NoError;
@@ -145,7 +155,7 @@ static bool WriteMazeSettingsToPreferences (const MazeSettings& mazeSettings)
 
 static bool GetMazeSettingsFromDialog (MazeSettings& mazeSettings)
 {
-	MazeSettings initialMazeSettings (10, 20, 1.0, true, true);
+	MazeSettings initialMazeSettings (10, 20, 1.0, MG::MazeAlgorithmType::Prim, 0, true, true, false);
 	LoadMazeSettingsFromPreferences (initialMazeSettings);
 
 	MazeSettingsDialog mazeSettingsDialog (initialMazeSettings);
@@ -165,8 +175,10 @@ static void GenerateMaze ()
 		return;
 	}
 
-	std::vector<MG::WallGeometry> mazeWalls;
-	GenerateMazeWallGeometries (mazeSettings.rowCount, mazeSettings.columnCount, mazeSettings.cellSize, mazeWalls);
+	std::uint64_t seed = mazeSettings.seed;
+	if (seed == 0) {
+		seed = (std::uint64_t) std::chrono::system_clock::now ().time_since_epoch ().count ();
+	}
 
 	static const double SlabPadding = 2.0;
 	double slabBegX = -SlabPadding;
@@ -175,17 +187,25 @@ static void GenerateMaze ()
 	double slabEndY = mazeSettings.cellSize * mazeSettings.rowCount + SlabPadding;
 
 	GS::UniString undoString = RSGetIndString (AddOnStringsID, UndoStringID, ACAPI_GetOwnResModule ());
+	GS::UniString progressString = RSGetIndString (AddOnStringsID, ProgressStringID, ACAPI_GetOwnResModule ());
 	ACAPI_CallUndoableCommand (undoString, [&] () -> GSErrCode {
 		GS::Array<API_Guid> placedElementGuids;
+		ProcessWindow_Init (undoString, 1);
+		ProcessWindow_SetNextPhase (progressString, ProgressMaxValue);
 		GSErrCode err = NoError;
-		for (const MG::WallGeometry& mazeWall : mazeWalls) {
-			API_Guid placedWallGuid;
-			err = CreateWallElement (mazeWall.begX, mazeWall.begY, mazeWall.endX, mazeWall.endY, placedWallGuid);
-			if (err != NoError) {
-				return APIERR_CANCEL;
-			}
-			placedElementGuids.Push (placedWallGuid);
+		size_t failedWallCount = 0;
+		err = PlaceMazeWalls (mazeSettings, seed, placedElementGuids, failedWallCount);
+		ProcessWindow_Close ();
+		if (err != NoError && err != APIERR_CANCEL) {
+			ACAPI_WriteReport (RSGetIndString (AddOnStringsID, ErrorStringID, ACAPI_GetOwnResModule ()), true);
+		}
+		if (err != NoError) {
+			return err;
 		}
+		if (failedWallCount > 0) {
+			ACAPI_WriteReport (RSGetIndString (AddOnStringsID, FailedWallsStringID, ACAPI_GetOwnResModule ()), true, (unsigned int) failedWallCount);
+		}
+
 		if (mazeSettings.createSlab) {
 			API_Guid placedSlabGuid;
 			err = CreateSlabElement (slabBegX, slabBegY, slabEndX, slabEndY, placedSlabGuid);
@@ -238,5 +258,6 @@ GSErrCode Initialize (void)
 
 GSErrCode FreeData (void)
 {
+	mazeCache.Clear ();
 	return NoError;
 }
@@ -1,19 +1,24 @@
 #include "MazeSettings.hpp"
 
-GS::ClassInfo MazeSettings::classInfo ("MazeSettings", GS::Guid ("B45089A9-B372-460B-B145-80E6EBF107C3"), GS::ClassVersion (1, 0));
+GS::ClassInfo MazeSettings::classInfo ("MazeSettings", GS::Guid ("B45089A9-B372-460B-B145-80E6EBF107C3"), GS::ClassVersion (1, 3));
+
+const UInt32 MazeSettings::MaxSeed;
 
 MazeSettings::MazeSettings () :
-	MazeSettings (0, 0, 0.0, false, false)
+	MazeSettings (0, 0, 0.0, MG::MazeAlgorithmType::Prim, 0, false, false, false)
 {
 
 }
 
-MazeSettings::MazeSettings (UInt32 rowCount, UInt32 columnCount, double cellSize, bool createGroup, bool createSlab) :
+MazeSettings::MazeSettings (UInt32 rowCount, UInt32 columnCount, double cellSize, MG::MazeAlgorithmType algorithm, UInt32 seed, bool createGroup, bool createSlab, bool mergeWalls) :
 	rowCount (rowCount),
 	columnCount (columnCount),
 	cellSize (cellSize),
+	algorithm (algorithm),
+	seed (seed),
 	createGroup (createGroup),
-	createSlab (createSlab)
+	createSlab (createSlab),
+	mergeWalls (mergeWalls)
 {
 
 }
@@ -26,6 +31,29 @@ GSErrCode MazeSettings::Read (GS::IChannel& ic)
 	ic.Read (cellSize);
 	ic.Read (createGroup);
 	ic.Read (createSlab);
+	if (frame.GetVersion ().GetMinorVersion () >= 1) {
+		Int32 algorithmValue = 0;
+		ic.Read (algorithmValue);
+		if (algorithmValue < 0 || algorithmValue > (Int32) MG::MazeAlgorithmType::Sidewinder) {
+			algorithmValue = 0;
+		}
+		algorithm = (MG::MazeAlgorithmType) algorithmValue;
+	} else {
+		algorithm = MG::MazeAlgorithmType::Prim;
+	}
+	if (frame.GetVersion ().GetMinorVersion () >= 2) {
+		ic.Read (mergeWalls);
+	} else {
+		mergeWalls = false;
+	}
+	if (frame.GetVersion ().GetMinorVersion () >= 3) {
+		ic.Read (seed);
+		if (seed > MaxSeed) {
+			seed = 0;
+		}
+	} else {
+		seed = 0;
+	}
 	return ic.GetInputStatus ();
 }
 
@@ -37,5 +65,8 @@ GSErrCode MazeSettings::Write (GS::OChannel& oc) const
 	oc.Write (cellSize);
 	oc.Write (createGroup);
 	oc.Write (createSlab);
+	oc.Write ((Int32) algorithm);
+	oc.Write (mergeWalls);
+	oc.Write (seed);
 	return oc.GetOutputStatus ();
 }
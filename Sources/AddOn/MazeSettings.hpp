@@ -2,23 +2,29 @@
 #define MAZESETTINGS_HPP
 
 #include "Object.hpp"
+#include "MazeGenerator.hpp"
 
 class MazeSettings : public GS::Object
 {
 	DECLARE_CLASS_INFO;
 
 public:
+	static const UInt32 MaxSeed = 2147483647;
+
 	MazeSettings ();
-	MazeSettings (UInt32 rowCount, UInt32 columnCount, double cellSize, bool createGroup, bool createSlab);
+	MazeSettings (UInt32 rowCount, UInt32 columnCount, double cellSize, MG::MazeAlgorithmType algorithm, UInt32 seed, bool createGroup, bool createSlab, bool mergeWalls);
 
 	virtual	GSErrCode	Read (GS::IChannel& ic) override;
 	virtual	GSErrCode	Write (GS::OChannel& oc) const override;
 
-	UInt32	rowCount;
-	UInt32	columnCount;
-	double	cellSize;
-	bool	createGroup;
-	bool	createSlab;
+	UInt32					rowCount;
+	UInt32					columnCount;
+	double					cellSize;
+	MG::MazeAlgorithmType	algorithm;
+	UInt32					seed;
+	bool					createGroup;
+	bool					createSlab;
+	bool					mergeWalls;
 };
 
 #endif
@@ -2,6 +2,8 @@
 #include "ResourceIds.hpp"
 #include "ACAPinc.h"
 
+#include <algorithm>
+
 enum DialogResourceIds
 {
 	MazeDialogResourceId = ID_ADDON_DLG,
@@ -19,7 +21,22 @@ enum DialogResourceIds
 	OptionsTextId = 12,
 	GroupElementsCheckId = 13,
 	PlaceSlabCheckId = 14,
-	Separator2Id = 15
+	Separator2Id = 15,
+	AlgorithmTextId = 16,
+	AlgorithmPopUpId = 17,
+	MergeWallsCheckId = 18,
+	SeedTextId = 19,
+	SeedEditId = 20
+};
+
+static const MG::MazeAlgorithmType PopUpAlgorithms[] = {
+	MG::MazeAlgorithmType::Prim,
+	MG::MazeAlgorithmType::Kruskal,
+	MG::MazeAlgorithmType::RecursiveBacktracker,
+	MG::MazeAlgorithmType::Wilson,
+	MG::MazeAlgorithmType::Eller,
+	MG::MazeAlgorithmType::BinaryTree,
+	MG::MazeAlgorithmType::Sidewinder
 };
 
 MazeSettingsDialog::MazeSettingsDialog (const MazeSettings& mazeSettings) :
@@ -29,8 +46,11 @@ MazeSettingsDialog::MazeSettingsDialog (const MazeSettings& mazeSettings) :
 	rowEdit (GetReference (), RowEditId),
 	columnEdit (GetReference (), ColumnEditId),
 	cellSizeEdit (GetReference (), CellSizeEditId),
+	algorithmPopUp (GetReference (), AlgorithmPopUpId),
+	seedEdit (GetReference (), SeedEditId),
 	groupElementsCheck (GetReference (), GroupElementsCheckId),
 	placeSlabCheck (GetReference (), PlaceSlabCheckId),
+	mergeWallsCheck (GetReference (), MergeWallsCheckId),
 	mazeSettings (mazeSettings)
 {
 	AttachToAllItems (*this);
@@ -53,8 +73,18 @@ void MazeSettingsDialog::PanelOpened (const DG::PanelOpenEvent&)
 	rowEdit.SetValue (mazeSettings.rowCount);
 	columnEdit.SetValue (mazeSettings.columnCount);
 	cellSizeEdit.SetValue (mazeSettings.cellSize);
+	short algorithmCount = (short) (sizeof (PopUpAlgorithms) / sizeof (PopUpAlgorithms[0]));
+	for (short i = 0; i < algorithmCount; i++) {
+		algorithmPopUp.AppendItem ();
+		algorithmPopUp.SetItemText (DG::PopUp::BottomItem, RSGetIndString (ID_ADDON_ALGORITHMS, i + 1, ACAPI_GetOwnResModule ()));
+		if (i == 0 || PopUpAlgorithms[i] == mazeSettings.algorithm) {
+			algorithmPopUp.SelectItem (i + 1);
+		}
+	}
+	seedEdit.SetValue ((Int32) std::min (mazeSettings.seed, MazeSettings::MaxSeed));
 	groupElementsCheck.SetState (mazeSettings.createGroup);
 	placeSlabCheck.SetState (mazeSettings.createSlab);
+	mergeWallsCheck.SetState (mazeSettings.mergeWalls);
 }
 
 void MazeSettingsDialog::PanelCloseRequested (const DG::PanelCloseRequestEvent& ev, bool*)
@@ -63,8 +93,11 @@ void MazeSettingsDialog::PanelCloseRequested (const DG::PanelCloseRequestEvent&
 		mazeSettings.rowCount = rowEdit.GetValue ();
 		mazeSettings.columnCount = columnEdit.GetValue ();
 		mazeSettings.cellSize = cellSizeEdit.GetValue ();
+		mazeSettings.algorithm = PopUpAlgorithms[algorithmPopUp.GetSelectedItem () - 1];
+		mazeSettings.seed = (UInt32) std::max (seedEdit.GetValue (), (Int32) 0);
 		mazeSettings.createGroup = groupElementsCheck.IsChecked ();
 		mazeSettings.createSlab = placeSlabCheck.IsChecked ();
+		mazeSettings.mergeWalls = mergeWallsCheck.IsChecked ();
 	}
 }
 
@@ -25,8 +25,11 @@ private:
 	DG::PosIntEdit	rowEdit;
 	DG::PosIntEdit	columnEdit;
 	DG::LengthEdit	cellSizeEdit;
+	DG::PopUp		algorithmPopUp;
+	DG::IntEdit		seedEdit;
 	DG::CheckBox	groupElementsCheck;
 	DG::CheckBox	placeSlabCheck;
+	DG::CheckBox	mergeWallsCheck;
 
 	MazeSettings	mazeSettings;
 };
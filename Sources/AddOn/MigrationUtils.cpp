@@ -37,4 +37,54 @@ GSErrCode ElementGroup_Create (const GS::Array<API_Guid>&	elemGuids, API_Guid* g
 #else
 	return ACAPI_ElementGroup_Create (elemGuids, groupGuid, parentGroupGuid);
 #endif
+}
+
+
+GSErrCode ProcessWindow_Init (const GS::UniString& title, Int32 phaseCount)
+{
+#if defined(ServerMainVers_2700)
+	return ACAPI_ProcessWindow_InitProcessWindow (&title, &phaseCount);
+#else
+	return ACAPI_Interface (APIIo_InitProcessWindowID, (void*) &title, &phaseCount);
+#endif
+}
+
+
+GSErrCode ProcessWindow_SetNextPhase (const GS::UniString& subtitle, Int32 maxValue)
+{
+#if defined(ServerMainVers_2700)
+	return ACAPI_ProcessWindow_SetNextProcessPhase (&subtitle, &maxValue);
+#else
+	return ACAPI_Interface (APIIo_SetNextProcessPhaseID, (void*) &subtitle, &maxValue);
+#endif
+}
+
+
+GSErrCode ProcessWindow_SetValue (Int32 value)
+{
+#if defined(ServerMainVers_2700)
+	return ACAPI_ProcessWindow_SetProcessValue (&value);
+#else
+	return ACAPI_Interface (APIIo_SetProcessValueID, &value, nullptr);
+#endif
+}
+
+
+bool ProcessWindow_IsCanceled ()
+{
+#if defined(ServerMainVers_2700)
+	return ACAPI_ProcessWindow_IsProcessCanceled ();
+#else
+	return ACAPI_Interface (APIIo_IsProcessCanceledID, nullptr, nullptr) != 0;
+#endif
+}
+
+
+GSErrCode ProcessWindow_Close ()
+{
+#if defined(ServerMainVers_2700)
+	return ACAPI_ProcessWindow_CloseProcessWindow ();
+#else
+	return ACAPI_Interface (APIIo_CloseProcessWindowID, nullptr, nullptr);
+#endif
 }
\ No newline at end of file
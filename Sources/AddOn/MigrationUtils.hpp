@@ -18,5 +18,10 @@ void SetAPIElementType (API_Element& element, API_ElemTypeID elemTypeId);
 GSErrCode Register_Menu (short menuStrResID, short promptStrResID, APIMenuCodeID menuPosCode, GSFlags menuFlags);
 GSErrCode Install_MenuHandler (short menuStrResID, APIMenuCommandProc* handlerProc);
 GSErrCode ElementGroup_Create (const GS::Array<API_Guid>& elemGuids, API_Guid* groupGuid = nullptr, const API_Guid* parentGroupGuid = nullptr);
+GSErrCode ProcessWindow_Init (const GS::UniString& title, Int32 phaseCount);
+GSErrCode ProcessWindow_SetNextPhase (const GS::UniString& subtitle, Int32 maxValue);
+GSErrCode ProcessWindow_SetValue (Int32 value);
+bool ProcessWindow_IsCanceled ();
+GSErrCode ProcessWindow_Close ();
 
 #endif
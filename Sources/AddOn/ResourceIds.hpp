@@ -5,5 +5,6 @@
 #define ID_ADDON_MENU		32500
 #define ID_ADDON_STRINGS	32501
 #define ID_ADDON_DLG		32502
+#define ID_ADDON_ALGORITHMS	32503
 
 #endif
@@ -0,0 +1,1044 @@
+#include "MazeGenerator.hpp"
+#include "MazeAlgorithms.hpp"
+#include "ParallelMazeGenerator.hpp"
+#include "WallPlacement.hpp"
+#include "PlacementPipeline.hpp"
+#include "WallPolylines.hpp"
+#include "MazeCache.hpp"
+#include "MazeFile.hpp"
+#include "MazeSolver.hpp"
+#include "MazeDistances.hpp"
+#include "MazeMetrics.hpp"
+#include "MazeBatch.hpp"
+#include "MazeRegion.hpp"
+#include "CellMask.hpp"
+#include "MazeBias.hpp"
+#include "LayeredMaze.hpp"
+#include "TopologyMaze.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined (_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#if defined (__GNUC__)
+#define ALLOCATION_NOINLINE __attribute__ ((noinline))
+#else
+#define ALLOCATION_NOINLINE
+#endif
+
+static std::atomic<std::uint64_t> allocationCount (0);
+static std::atomic<std::uint64_t> allocatedBytes (0);
+
+ALLOCATION_NOINLINE void* operator new (std::size_t size)
+{
+	allocationCount.fetch_add (1, std::memory_order_relaxed);
+	allocatedBytes.fetch_add (size, std::memory_order_relaxed);
+	void* ptr = std::malloc (size == 0 ? 1 : size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc ();
+	}
+	return ptr;
+}
+
+ALLOCATION_NOINLINE void* operator new[] (std::size_t size)
+{
+	return operator new (size);
+}
+
+ALLOCATION_NOINLINE void operator delete (void* ptr) noexcept
+{
+	std::free (ptr);
+}
+
+ALLOCATION_NOINLINE void operator delete[] (void* ptr) noexcept
+{
+	std::free (ptr);
+}
+
+ALLOCATION_NOINLINE void operator delete (void* ptr, std::size_t) noexcept
+{
+	std::free (ptr);
+}
+
+ALLOCATION_NOINLINE void operator delete[] (void* ptr, std::size_t) noexcept
+{
+	std::free (ptr);
+}
+
+namespace MemoryUsage
+{
+
+static void ResetPeak ()
+{
+#if defined (__linux__)
+	std::FILE* clearRefs = std::fopen ("/proc/self/clear_refs", "w");
+	if (clearRefs != nullptr) {
+		std::fputs ("5", clearRefs);
+		std::fclose (clearRefs);
+	}
+#endif
+}
+
+static std::uint64_t GetPeak ()
+{
+#if defined (_WIN32)
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo (GetCurrentProcess (), &counters, sizeof (counters))) {
+		return 0;
+	}
+	return counters.PeakWorkingSetSize;
+#elif defined (__linux__)
+	std::FILE* status = std::fopen ("/proc/self/status", "r");
+	if (status != nullptr) {
+		char line[256];
+		unsigned long long peakKb = 0;
+		while (std::fgets (line, sizeof (line), status) != nullptr) {
+			if (std::sscanf (line, "VmHWM: %llu kB", &peakKb) == 1) {
+				break;
+			}
+		}
+		std::fclose (status);
+		if (peakKb > 0) {
+			return peakKb * 1024;
+		}
+	}
+	struct rusage usage;
+	getrusage (RUSAGE_SELF, &usage);
+	return (std::uint64_t) usage.ru_maxrss * 1024;
+#else
+	struct rusage usage;
+	getrusage (RUSAGE_SELF, &usage);
+	return (std::uint64_t) usage.ru_maxrss;
+#endif
+}
+
+}
+
+class BenchmarkState
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator (BenchmarkState* state, std::int64_t remaining);
+
+		bool		operator!= (const Iterator& other);
+		void		operator++ ();
+		int			operator* () const;
+
+	private:
+		BenchmarkState*	state;
+		std::int64_t	remaining;
+	};
+
+	BenchmarkState (int size, std::int64_t iterations);
+
+	int				GetSize () const;
+	std::int64_t	GetIterations () const;
+	void			SetCellsProcessed (std::int64_t newCellsProcessed);
+
+	Iterator		begin ();
+	Iterator		end ();
+
+	double			GetElapsedSeconds () const;
+	std::int64_t	GetCellsProcessed () const;
+	std::uint64_t	GetAllocationCount () const;
+	std::uint64_t	GetAllocatedBytes () const;
+
+private:
+	void			StartTiming ();
+	void			StopTiming ();
+
+	int										size;
+	std::int64_t							iterations;
+	std::int64_t							cellsProcessed;
+	bool									running;
+	std::chrono::steady_clock::time_point	startTime;
+	double									elapsedSeconds;
+	std::uint64_t							startAllocationCount;
+	std::uint64_t							startAllocatedBytes;
+	std::uint64_t							allocationCountDiff;
+	std::uint64_t							allocatedBytesDiff;
+};
+
+BenchmarkState::Iterator::Iterator (BenchmarkState* state, std::int64_t remaining) :
+	state (state),
+	remaining (remaining)
+{
+
+}
+
+bool BenchmarkState::Iterator::operator!= (const Iterator&)
+{
+	if (remaining > 0) {
+		return true;
+	}
+	state->StopTiming ();
+	return false;
+}
+
+void BenchmarkState::Iterator::operator++ ()
+{
+	remaining--;
+}
+
+int BenchmarkState::Iterator::operator* () const
+{
+	return 0;
+}
+
+BenchmarkState::BenchmarkState (int size, std::int64_t iterations) :
+	size (size),
+	iterations (iterations),
+	cellsProcessed (0),
+	running (false),
+	startTime (),
+	elapsedSeconds (0.0),
+	startAllocationCount (0),
+	startAllocatedBytes (0),
+	allocationCountDiff (0),
+	allocatedBytesDiff (0)
+{
+
+}
+
+int BenchmarkState::GetSize () const
+{
+	return size;
+}
+
+std::int64_t BenchmarkState::GetIterations () const
+{
+	return iterations;
+}
+
+void BenchmarkState::SetCellsProcessed (std::int64_t newCellsProcessed)
+{
+	cellsProcessed = newCellsProcessed;
+}
+
+BenchmarkState::Iterator BenchmarkState::begin ()
+{
+	StartTiming ();
+	return Iterator (this, iterations);
+}
+
+BenchmarkState::Iterator BenchmarkState::end ()
+{
+	return Iterator (this, 0);
+}
+
+double BenchmarkState::GetElapsedSeconds () const
+{
+	return elapsedSeconds;
+}
+
+std::int64_t BenchmarkState::GetCellsProcessed () const
+{
+	return cellsProcessed;
+}
+
+std::uint64_t BenchmarkState::GetAllocationCount () const
+{
+	return allocationCountDiff;
+}
+
+std::uint64_t BenchmarkState::GetAllocatedBytes () const
+{
+	return allocatedBytesDiff;
+}
+
+void BenchmarkState::StartTiming ()
+{
+	running = true;
+	startAllocationCount = allocationCount.load ();
+	startAllocatedBytes = allocatedBytes.load ();
+	startTime = std::chrono::steady_clock::now ();
+}
+
+void BenchmarkState::StopTiming ()
+{
+	if (!running) {
+		return;
+	}
+	elapsedSeconds = std::chrono::duration<double> (std::chrono::steady_clock::now () - startTime).count ();
+	allocationCountDiff = allocationCount.load () - startAllocationCount;
+	allocatedBytesDiff = allocatedBytes.load () - startAllocatedBytes;
+	running = false;
+}
+
+using BenchmarkFunction = std::function<void (BenchmarkState&)>;
+
+class Benchmark
+{
+public:
+	Benchmark (const std::string& name, const BenchmarkFunction& function);
+	Benchmark (const std::string& name, const BenchmarkFunction& function, const std::vector<int>& sizes);
+
+	std::string			name;
+	BenchmarkFunction	function;
+	std::vector<int>	sizes;
+};
+
+static const std::vector<int> DefaultBenchmarkSizes = { 10, 100, 1000, 4000 };
+static const std::vector<int> LargeBenchmarkSizes = { 4000, 16000 };
+
+Benchmark::Benchmark (const std::string& name, const BenchmarkFunction& function) :
+	Benchmark (name, function, DefaultBenchmarkSizes)
+{
+
+}
+
+Benchmark::Benchmark (const std::string& name, const BenchmarkFunction& function, const std::vector<int>& sizes) :
+	name (name),
+	function (function),
+	sizes (sizes)
+{
+
+}
+
+class BenchmarkResult
+{
+public:
+	BenchmarkResult ();
+
+	std::string		name;
+	int				size;
+	std::int64_t	iterations;
+	double			realTimeMs;
+	double			cellsPerSecond;
+	double			allocationsPerIteration;
+	double			allocatedBytesPerIteration;
+	std::uint64_t	peakRss;
+};
+
+BenchmarkResult::BenchmarkResult () :
+	name (),
+	size (0),
+	iterations (0),
+	realTimeMs (0.0),
+	cellsPerSecond (0.0),
+	allocationsPerIteration (0.0),
+	allocatedBytesPerIteration (0.0),
+	peakRss (0)
+{
+
+}
+
+static void BM_MazeReset (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::Maze maze;
+	for (auto iteration : state) {
+		(void) iteration;
+		maze.Reset (size, size);
+	}
+	state.SetCellsProcessed (state.GetIterations () * size * size);
+}
+
+static void BM_MazeAddRemoveWall (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::Maze maze (size, size);
+	for (auto iteration : state) {
+		(void) iteration;
+		for (int row = 0; row < size; row++) {
+			for (int col = 0; col < size; col++) {
+				maze.RemoveWall (maze.GetWallId (row, col, MG::Direction::Right));
+				maze.RemoveWall (maze.GetWallId (row, col, MG::Direction::Bottom));
+			}
+		}
+		for (int row = 0; row < size; row++) {
+			for (int col = 0; col < size; col++) {
+				maze.AddWall (row, col, MG::Direction::Right);
+				maze.AddWall (row, col, MG::Direction::Bottom);
+			}
+		}
+	}
+	state.SetCellsProcessed (state.GetIterations () * size * size);
+}
+
+static BenchmarkFunction BM_MazeGeneratorGenerate (MG::MazeAlgorithmType algorithmType)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		for (auto iteration : state) {
+			(void) iteration;
+			MG::MazeGenerator generator (size, size, 1, algorithmType);
+			generator.Generate ();
+		}
+		state.SetCellsProcessed (state.GetIterations () * size * size);
+	};
+}
+
+static BenchmarkFunction BM_MazeGeneratorGenerateInArena (MG::MazeAlgorithmType algorithmType)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		MG::MemoryArena arena;
+		{
+			MG::MazeGenerator generator (size, size, 1, algorithmType, arena);
+			generator.Generate ();
+		}
+		arena.Reset ();
+		for (auto iteration : state) {
+			(void) iteration;
+			arena.Reset ();
+			MG::MazeGenerator generator (size, size, 1, algorithmType, arena);
+			generator.Generate ();
+		}
+		state.SetCellsProcessed (state.GetIterations () * size * size);
+	};
+}
+
+static MG::CellMask CreateRingMask (int size)
+{
+	MG::CellMask cellMask (size, size, false);
+	double outerRadius = size / 2.0;
+	double innerRadius = outerRadius - std::max (size / 20.0, 2.0);
+	for (int row = 0; row < size; row++) {
+		for (int col = 0; col < size; col++) {
+			double dx = col + 0.5 - outerRadius;
+			double dy = row + 0.5 - outerRadius;
+			double distance = std::sqrt (dx * dx + dy * dy);
+			cellMask.SetCellActive (row, col, distance >= innerRadius && distance < outerRadius);
+		}
+	}
+	return cellMask;
+}
+
+static BenchmarkFunction BM_MazeGeneratorGenerateInRing (MG::MazeAlgorithmType algorithmType)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		MG::CellMask cellMask = CreateRingMask (size);
+		bool succeeded = true;
+		for (auto iteration : state) {
+			(void) iteration;
+			MG::MazeGenerator generator (cellMask, 1, algorithmType);
+			succeeded = generator.Generate () && succeeded;
+		}
+		state.SetCellsProcessed (succeeded ? state.GetIterations () * cellMask.GetActiveCellCount () : 0);
+	};
+}
+
+static void BM_MazeGeneratorGenerateWeighted (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::MazeBiasField biasField (size, size);
+	for (int row = 0; row < size; row++) {
+		for (int col = 0; col < size; col++) {
+			if (row < size / 3) {
+				biasField.SetCellBias (row, col, 16.0, 1.0);
+			} else if (row >= size - size / 3) {
+				biasField.SetCellBias (row, col, 1.0, 16.0);
+			}
+		}
+	}
+	bool succeeded = true;
+	for (auto iteration : state) {
+		(void) iteration;
+		MG::MazeGenerator generator (biasField, 1);
+		succeeded = generator.Generate () && succeeded;
+	}
+	state.SetCellsProcessed (succeeded ? state.GetIterations () * size * size : 0);
+}
+
+static BenchmarkFunction BM_MazeGetWallGeometries (int threadCount)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		MG::MazeGenerator generator (size, size, 1);
+		generator.Generate ();
+		const MG::Maze& maze = generator.GetMaze ();
+		size_t wallCount = 0;
+		for (auto iteration : state) {
+			(void) iteration;
+			wallCount += maze.GetWallGeometries (1.0, threadCount).size ();
+		}
+		state.SetCellsProcessed (wallCount > 0 ? state.GetIterations () * size * size : 0);
+	};
+}
+
+static void BM_TraceWallPolylines (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::MazeGenerator generator (size, size, 1);
+	generator.Generate ();
+	const MG::Maze& maze = generator.GetMaze ();
+	size_t polylineCount = 0;
+	for (auto iteration : state) {
+		(void) iteration;
+		polylineCount += MG::TraceWallPolylines (maze.GetWallBits (), 1.0).GetPolylineCount ();
+	}
+	state.SetCellsProcessed (polylineCount > 0 ? state.GetIterations () * size * size : 0);
+}
+
+static BenchmarkFunction BM_SolveMaze (MG::MazeSolverType solverType)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		MG::MazeGenerator generator (size, size, 1);
+		generator.Generate ();
+		bool found = true;
+		for (auto iteration : state) {
+			(void) iteration;
+			found = found && MG::SolveMaze (generator.GetMaze (), solverType).found;
+		}
+		state.SetCellsProcessed (found ? state.GetIterations () * size * size : 0);
+	};
+}
+
+static BenchmarkFunction BM_ComputeDistanceField (MG::MazeAlgorithmType algorithmType, int threadCount)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		MG::MazeGenerator generator (size, size, 1, algorithmType);
+		generator.Generate ();
+		size_t reachedCellCount = 0;
+		for (auto iteration : state) {
+			(void) iteration;
+			reachedCellCount += MG::ComputeDistanceField (generator.GetMaze ().GetWallBits (), 0, threadCount).reachedCellCount;
+		}
+		state.SetCellsProcessed ((std::int64_t) reachedCellCount);
+	};
+}
+
+static void BM_ComputeMazeDiameter (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::MazeGenerator generator (size, size, 1);
+	generator.Generate ();
+	bool succeeded = true;
+	for (auto iteration : state) {
+		(void) iteration;
+		succeeded = succeeded && MG::ComputeMazeDiameter (generator.GetMaze ().GetWallBits (), 0).endCellId != MG::InvalidCellId;
+	}
+	state.SetCellsProcessed (succeeded ? state.GetIterations () * size * size * 2 : 0);
+}
+
+static void BM_ComputeMazeMetrics (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::MazeGenerator generator (size, size, 1);
+	generator.Generate ();
+	size_t cellCount = 0;
+	for (auto iteration : state) {
+		(void) iteration;
+		cellCount += MG::ComputeMazeMetrics (generator.GetMaze ()).cellCount;
+	}
+	state.SetCellsProcessed ((std::int64_t) cellCount);
+}
+
+static void BM_FindBestMazeSeed (BenchmarkState& state)
+{
+	const size_t candidateCount = 16;
+	int size = state.GetSize ();
+	size_t evaluatedCount = 0;
+	for (auto iteration : state) {
+		(void) iteration;
+		evaluatedCount += MG::FindBestMazeSeed (size, size, MG::MazeAlgorithmType::Prim, 1, candidateCount, MG::MazeMetricType::SolutionLength, true, 0).candidateCount;
+	}
+	state.SetCellsProcessed ((std::int64_t) evaluatedCount * size * size);
+}
+
+static BenchmarkFunction BM_MazeBatchGeneratorRun (int threadCount)
+{
+	return [=] (BenchmarkState& state) {
+		const size_t jobCount = 64;
+		int size = state.GetSize ();
+		std::vector<MG::MazeBatchJob> jobs;
+		for (size_t jobIndex = 0; jobIndex < jobCount; jobIndex++) {
+			jobs.push_back (MG::MazeBatchJob (size, size, jobIndex + 1, MG::MazeAlgorithmType::Prim));
+		}
+		MG::MazeBatchGenerator batchGenerator (threadCount);
+		size_t generatedCount = 0;
+		for (auto iteration : state) {
+			(void) iteration;
+			batchGenerator.Run (jobs, [&] (MG::MazeBatchResult& result) {
+				generatedCount += (result.succeeded ? 1 : 0);
+				return true;
+			});
+		}
+		state.SetCellsProcessed ((std::int64_t) generatedCount * size * size);
+	};
+}
+
+static BenchmarkFunction BM_ParallelMazeGeneratorGenerate (int threadCount)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		bool succeeded = true;
+		for (auto iteration : state) {
+			(void) iteration;
+			MG::ParallelMazeGenerator generator (size, size, 1, threadCount);
+			succeeded = generator.Generate () && succeeded;
+		}
+		state.SetCellsProcessed (succeeded ? state.GetIterations () * size * size : 0);
+	};
+}
+
+static BenchmarkFunction BM_LayeredMazeGeneratorGenerate (int threadCount)
+{
+	return [=] (BenchmarkState& state) {
+		const int layerCount = 8;
+		int size = state.GetSize ();
+		bool succeeded = true;
+		for (auto iteration : state) {
+			(void) iteration;
+			MG::LayeredMazeGenerator generator (layerCount, size, size, 1, threadCount);
+			succeeded = generator.Generate () && succeeded;
+		}
+		state.SetCellsProcessed (succeeded ? state.GetIterations () * layerCount * size * size : 0);
+	};
+}
+
+static size_t GetGeometryItemCount (const std::vector<MG::WallGeometry>& wallGeometries)
+{
+	return wallGeometries.size ();
+}
+
+static size_t GetGeometryItemCount (const MG::WallPolylines& wallPolylines)
+{
+	return wallPolylines.GetPolylineCount ();
+}
+
+static size_t GetGeometryItemCount (const MG::PolarWallGeometry& wallGeometry)
+{
+	return wallGeometry.radialWalls.size () + wallGeometry.arcWalls.size ();
+}
+
+template <typename Topology>
+static void BM_TopologyMazeGenerate (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::TopologyMaze<Topology> maze (size, size);
+	bool succeeded = true;
+	for (auto iteration : state) {
+		(void) iteration;
+		MG::Xoshiro256Engine randomEngine (1);
+		succeeded = maze.Generate (randomEngine) && succeeded;
+	}
+	state.SetCellsProcessed (succeeded ? state.GetIterations () * maze.GetCellCount () : 0);
+}
+
+template <typename Topology>
+static void BM_TopologyMazeGetWallGeometries (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::TopologyMaze<Topology> maze (size, size);
+	MG::Xoshiro256Engine randomEngine (1);
+	maze.Generate (randomEngine);
+	size_t itemCount = 0;
+	for (auto iteration : state) {
+		(void) iteration;
+		itemCount += GetGeometryItemCount (maze.GetWallGeometries (1.0));
+	}
+	state.SetCellsProcessed (itemCount > 0 ? state.GetIterations () * maze.GetCellCount () : 0);
+}
+
+template <typename Topology>
+static void AddTopologyBenchmarks (std::vector<Benchmark>& benchmarks)
+{
+	benchmarks.push_back (Benchmark (std::string ("TopologyMaze::Generate/") + Topology::GetName (), BM_TopologyMazeGenerate<Topology>));
+	benchmarks.push_back (Benchmark (std::string ("TopologyMaze::GetWallGeometries/") + Topology::GetName (), BM_TopologyMazeGetWallGeometries<Topology>));
+}
+
+static void BM_RegenerateMazeRegion (BenchmarkState& state)
+{
+	const int regionSize = 64;
+	int size = state.GetSize ();
+	MG::MazeGenerator generator (size, size, 1);
+	generator.Generate ();
+	MG::Maze maze = generator.GetMaze ();
+	int regionRowCount = std::min (size, regionSize);
+	int regionColCount = std::min (size, regionSize);
+	MG::MazeRegion region ((size - regionRowCount) / 2, (size - regionColCount) / 2, regionRowCount, regionColCount);
+	MG::Xoshiro256Engine randomEngine (1);
+	MG::MazeWallDiff diff;
+	bool succeeded = true;
+	for (auto iteration : state) {
+		(void) iteration;
+		succeeded = succeeded && MG::RegenerateMazeRegion (maze, region, randomEngine, 1.0, diff);
+	}
+	state.SetCellsProcessed (succeeded ? state.GetIterations () * regionRowCount * regionColCount : 0);
+}
+
+static void BM_MazeCacheGetWallGeometries (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::MazeCache mazeCache (std::numeric_limits<size_t>::max ());
+	MG::MazeCacheKey key (size, size, 1, MG::MazeAlgorithmType::Prim);
+	mazeCache.GetWallGeometries (key, 1.0);
+	for (auto iteration : state) {
+		(void) iteration;
+		mazeCache.GetWallGeometries (key, 1.0);
+	}
+	MG::MazeCacheStats stats = mazeCache.GetStats ();
+	state.SetCellsProcessed (stats.missCount == 1 ? state.GetIterations () * size * size : 0);
+}
+
+static BenchmarkFunction BM_MappedMazeFileOpen (bool verifyChecksum)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		std::string path = "maze-benchmark-" + std::to_string (size) + ".mgwb";
+		MG::MazeGenerator generator (size, size, 1);
+		generator.Generate ();
+		bool succeeded = MG::WriteMazeFile (path, generator.GetMaze (), 1, MG::MazeAlgorithmType::Prim);
+		for (auto iteration : state) {
+			(void) iteration;
+			MG::MappedMazeFile mappedFile;
+			succeeded = succeeded && mappedFile.Open (path, verifyChecksum);
+		}
+		std::remove (path.c_str ());
+		state.SetCellsProcessed (succeeded ? state.GetIterations () * size * size : 0);
+	};
+}
+
+static const double MockWallThickness = 0.3;
+
+class MockWallElement
+{
+public:
+	MockWallElement ();
+
+	std::uint64_t	guid;
+	double			begX;
+	double			begY;
+	double			endX;
+	double			endY;
+	double			attributes[60];
+};
+
+MockWallElement::MockWallElement () :
+	guid (0),
+	begX (0.0),
+	begY (0.0),
+	endX (0.0),
+	endY (0.0),
+	attributes ()
+{
+
+}
+
+class MockWallPlacementBackend : public MG::WallPlacementBackend
+{
+public:
+	MockWallPlacementBackend ();
+
+	virtual bool	BeginPlacement (size_t wallCount) override;
+	virtual size_t	PlaceWalls (const MG::WallGeometry* walls, size_t wallCount) override;
+	virtual size_t	PlacePolylines (const MG::WallPolylines& polylines) override;
+
+	size_t			GetPlacedWallCount () const;
+
+private:
+	MockWallElement				wallTemplate;
+	std::vector<std::uint64_t>	placedGuids;
+};
+
+MockWallPlacementBackend::MockWallPlacementBackend () :
+	wallTemplate (),
+	placedGuids ()
+{
+
+}
+
+bool MockWallPlacementBackend::BeginPlacement (size_t wallCount)
+{
+	wallTemplate = MockWallElement ();
+	placedGuids.clear ();
+	placedGuids.reserve (wallCount);
+	return true;
+}
+
+size_t MockWallPlacementBackend::PlaceWalls (const MG::WallGeometry* walls, size_t wallCount)
+{
+	for (size_t i = 0; i < wallCount; i++) {
+		MockWallElement wallElement = wallTemplate;
+		wallElement.begX = walls[i].begX;
+		wallElement.begY = walls[i].begY;
+		wallElement.endX = walls[i].endX;
+		wallElement.endY = walls[i].endY;
+		wallElement.guid = placedGuids.size () + 1;
+		placedGuids.push_back (wallElement.guid);
+	}
+	return wallCount;
+}
+
+size_t MockWallPlacementBackend::PlacePolylines (const MG::WallPolylines& polylines)
+{
+	for (size_t i = 0; i < polylines.GetPolylineCount (); i++) {
+		const MG::WallPoint* points = polylines.GetPoints (i);
+		size_t pointCount = polylines.GetPointCount (i);
+		MockWallElement wallElement = wallTemplate;
+		wallElement.begX = points[0].x;
+		wallElement.begY = points[0].y;
+		wallElement.endX = points[pointCount - 1].x;
+		wallElement.endY = points[pointCount - 1].y;
+		if (pointCount > 2) {
+			wallElement.attributes[0] = (double) MG::GetWallPolylineOutline (points, pointCount, MockWallThickness).size ();
+		}
+		wallElement.guid = placedGuids.size () + 1;
+		placedGuids.push_back (wallElement.guid);
+	}
+	return polylines.GetPolylineCount ();
+}
+
+size_t MockWallPlacementBackend::GetPlacedWallCount () const
+{
+	return placedGuids.size ();
+}
+
+static void BM_WallPlacerPlaceWalls (BenchmarkState& state)
+{
+	int size = state.GetSize ();
+	MG::MazeGenerator generator (size, size, 1);
+	generator.Generate ();
+	std::vector<MG::WallGeometry> walls = generator.GetMaze ().GetWallGeometries (1.0);
+	MockWallPlacementBackend backend;
+	MG::WallPlacer wallPlacer (backend);
+	for (auto iteration : state) {
+		(void) iteration;
+		wallPlacer.PlaceWalls (walls);
+	}
+	state.SetCellsProcessed (backend.GetPlacedWallCount () == walls.size () ? state.GetIterations () * size * size : 0);
+}
+
+static BenchmarkFunction BM_PlacementPipelineRun (MG::MazeAlgorithmType algorithmType, bool mergeWalls)
+{
+	return [=] (BenchmarkState& state) {
+		int size = state.GetSize ();
+		MockWallPlacementBackend backend;
+		bool succeeded = true;
+		for (auto iteration : state) {
+			(void) iteration;
+			MG::PlacementPipeline pipeline (size, size, 1, algorithmType, 1.0);
+			pipeline.SetMergeWalls (mergeWalls);
+			MG::CancellationToken cancellationToken;
+			succeeded = succeeded && pipeline.Run (backend, cancellationToken).status == MG::PlacementStatus::Completed;
+		}
+		state.SetCellsProcessed (succeeded ? state.GetIterations () * size * size : 0);
+	};
+}
+
+static std::vector<Benchmark> CreateBenchmarks ()
+{
+	std::vector<Benchmark> benchmarks;
+	benchmarks.push_back (Benchmark ("Maze::Reset", BM_MazeReset));
+	benchmarks.push_back (Benchmark ("Maze::AddWall+RemoveWall", BM_MazeAddRemoveWall));
+	for (MG::MazeAlgorithmType algorithmType : MG::GetAllMazeAlgorithmTypes ()) {
+		benchmarks.push_back (Benchmark (std::string ("MazeGenerator::Generate/") + MG::GetMazeAlgorithmName (algorithmType), BM_MazeGeneratorGenerate (algorithmType)));
+		benchmarks.push_back (Benchmark (std::string ("MazeGenerator::Generate/") + MG::GetMazeAlgorithmName (algorithmType) + "/arena", BM_MazeGeneratorGenerateInArena (algorithmType)));
+	}
+	for (MG::MazeAlgorithmType algorithmType : { MG::MazeAlgorithmType::Prim, MG::MazeAlgorithmType::Kruskal, MG::MazeAlgorithmType::RecursiveBacktracker, MG::MazeAlgorithmType::Wilson }) {
+		benchmarks.push_back (Benchmark (std::string ("MazeGenerator::Generate/") + MG::GetMazeAlgorithmName (algorithmType) + "/ring", BM_MazeGeneratorGenerateInRing (algorithmType)));
+	}
+	benchmarks.push_back (Benchmark ("MazeGenerator::Generate/prim/weighted", BM_MazeGeneratorGenerateWeighted));
+	benchmarks.push_back (Benchmark ("Maze::GetWallGeometries/serial", BM_MazeGetWallGeometries (1)));
+	benchmarks.push_back (Benchmark ("Maze::GetWallGeometries/parallel", BM_MazeGetWallGeometries (0)));
+	benchmarks.push_back (Benchmark ("TraceWallPolylines", BM_TraceWallPolylines));
+	for (MG::MazeSolverType solverType : MG::GetAllMazeSolverTypes ()) {
+		benchmarks.push_back (Benchmark (std::string ("SolveMaze/") + MG::GetMazeSolverName (solverType), BM_SolveMaze (solverType)));
+	}
+	for (MG::MazeAlgorithmType algorithmType : { MG::MazeAlgorithmType::Prim, MG::MazeAlgorithmType::BinaryTree }) {
+		for (int threadCount : { 1, 2, 4, 8 }) {
+			std::string name = std::string ("ComputeDistanceField/") + MG::GetMazeAlgorithmName (algorithmType) + "/threads:" + std::to_string (threadCount);
+			benchmarks.push_back (Benchmark (name, BM_ComputeDistanceField (algorithmType, threadCount)));
+		}
+	}
+	benchmarks.push_back (Benchmark ("ComputeMazeDiameter", BM_ComputeMazeDiameter));
+	benchmarks.push_back (Benchmark ("ComputeMazeMetrics", BM_ComputeMazeMetrics));
+	benchmarks.push_back (Benchmark ("FindBestMazeSeed/16", BM_FindBestMazeSeed));
+	for (int threadCount : { 1, 2, 4, 8 }) {
+		benchmarks.push_back (Benchmark ("MazeBatchGenerator::Run/64/threads:" + std::to_string (threadCount), BM_MazeBatchGeneratorRun (threadCount)));
+	}
+	for (int threadCount : { 1, 2, 4, 8 }) {
+		benchmarks.push_back (Benchmark ("ParallelMazeGenerator::Generate/threads:" + std::to_string (threadCount), BM_ParallelMazeGeneratorGenerate (threadCount), LargeBenchmarkSizes));
+	}
+	for (int threadCount : { 1, 2, 4, 8 }) {
+		benchmarks.push_back (Benchmark ("LayeredMazeGenerator::Generate/8/threads:" + std::to_string (threadCount), BM_LayeredMazeGeneratorGenerate (threadCount)));
+	}
+	AddTopologyBenchmarks<MG::SquareTopology> (benchmarks);
+	AddTopologyBenchmarks<MG::HexTopology> (benchmarks);
+	AddTopologyBenchmarks<MG::TriangleTopology> (benchmarks);
+	AddTopologyBenchmarks<MG::PolarTopology> (benchmarks);
+	benchmarks.push_back (Benchmark ("RegenerateMazeRegion/64x64", BM_RegenerateMazeRegion));
+	benchmarks.push_back (Benchmark ("MazeCache::GetWallGeometries/hit", BM_MazeCacheGetWallGeometries));
+	benchmarks.push_back (Benchmark ("MappedMazeFile::Open", BM_MappedMazeFileOpen (false)));
+	benchmarks.push_back (Benchmark ("MappedMazeFile::Open/verified", BM_MappedMazeFileOpen (true)));
+	benchmarks.push_back (Benchmark ("WallPlacer::PlaceWalls/mock", BM_WallPlacerPlaceWalls));
+	benchmarks.push_back (Benchmark ("PlacementPipeline::Run/prim/mock", BM_PlacementPipelineRun (MG::MazeAlgorithmType::Prim, false)));
+	benchmarks.push_back (Benchmark ("PlacementPipeline::Run/eller/mock", BM_PlacementPipelineRun (MG::MazeAlgorithmType::Eller, false)));
+	benchmarks.push_back (Benchmark ("PlacementPipeline::Run/prim/merged/mock", BM_PlacementPipelineRun (MG::MazeAlgorithmType::Prim, true)));
+	return benchmarks;
+}
+
+static BenchmarkResult RunBenchmark (const Benchmark& benchmark, int size, double minTime)
+{
+	std::int64_t iterations = 1;
+	MemoryUsage::ResetPeak ();
+	while (true) {
+		BenchmarkState state (size, iterations);
+		benchmark.function (state);
+		double elapsed = state.GetElapsedSeconds ();
+		if (elapsed >= minTime || iterations >= 1000000000) {
+			BenchmarkResult result;
+			result.name = benchmark.name + "/" + std::to_string (size) + "x" + std::to_string (size);
+			result.size = size;
+			result.iterations = iterations;
+			result.realTimeMs = elapsed * 1000.0 / iterations;
+			result.cellsPerSecond = (elapsed > 0.0 ? state.GetCellsProcessed () / elapsed : 0.0);
+			result.allocationsPerIteration = (double) state.GetAllocationCount () / iterations;
+			result.allocatedBytesPerIteration = (double) state.GetAllocatedBytes () / iterations;
+			result.peakRss = MemoryUsage::GetPeak ();
+			return result;
+		}
+		double multiplier = (elapsed > 0.0 ? minTime * 1.4 / elapsed : 10.0);
+		if (multiplier > 10.0) {
+			multiplier = 10.0;
+		}
+		std::int64_t nextIterations = (std::int64_t) (iterations * multiplier);
+		iterations = (nextIterations > iterations ? nextIterations : iterations + 1);
+	}
+}
+
+static std::string EscapeJson (const std::string& text)
+{
+	std::string result;
+	for (char c : text) {
+		if (c == '"' || c == '\\') {
+			result += '\\';
+		}
+		result += c;
+	}
+	return result;
+}
+
+static void WriteJson (std::FILE* output, const std::vector<BenchmarkResult>& results)
+{
+	char dateString[64] = {};
+	std::time_t now = std::time (nullptr);
+	std::strftime (dateString, sizeof (dateString), "%Y-%m-%dT%H:%M:%S", std::localtime (&now));
+
+	std::fprintf (output, "{\n");
+	std::fprintf (output, "  \"context\": {\n");
+	std::fprintf (output, "    \"date\": \"%s\",\n", dateString);
+	std::fprintf (output, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency ());
+#if defined (NDEBUG)
+	std::fprintf (output, "    \"library_build_type\": \"release\"\n");
+#else
+	std::fprintf (output, "    \"library_build_type\": \"debug\"\n");
+#endif
+	std::fprintf (output, "  },\n");
+	std::fprintf (output, "  \"benchmarks\": [\n");
+	for (size_t i = 0; i < results.size (); i++) {
+		const BenchmarkResult& result = results[i];
+		std::fprintf (output, "    {\n");
+		std::fprintf (output, "      \"name\": \"%s\",\n", EscapeJson (result.name).c_str ());
+		std::fprintf (output, "      \"size\": %d,\n", result.size);
+		std::fprintf (output, "      \"iterations\": %lld,\n", (long long) result.iterations);
+		std::fprintf (output, "      \"real_time\": %.6f,\n", result.realTimeMs);
+		std::fprintf (output, "      \"time_unit\": \"ms\",\n");
+		std::fprintf (output, "      \"cells_per_second\": %.1f,\n", result.cellsPerSecond);
+		std::fprintf (output, "      \"allocations_per_iteration\": %.2f,\n", result.allocationsPerIteration);
+		std::fprintf (output, "      \"allocated_bytes_per_iteration\": %.0f,\n", result.allocatedBytesPerIteration);
+		std::fprintf (output, "      \"peak_rss_bytes\": %llu\n", (unsigned long long) result.peakRss);
+		std::fprintf (output, "    }%s\n", (i + 1 < results.size () ? "," : ""));
+	}
+	std::fprintf (output, "  ]\n");
+	std::fprintf (output, "}\n");
+}
+
+static void PrintUsage ()
+{
+	std::fprintf (stderr,
+		"Usage: maze-benchmark [options]\n"
+		"  --filter <text>        run only benchmarks whose name contains text\n"
+		"  --max-size <size>      largest grid dimension to run, ParallelMazeGenerator also has 16000 (default: 4000)\n"
+		"  --min-time <seconds>   minimum measured time per benchmark (default: 0.5)\n"
+		"  --output <path>        JSON output file (default: stdout)\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	std::string filter;
+	std::string outputPath;
+	int maxSize = 4000;
+	double minTime = 0.5;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			PrintUsage ();
+			return 1;
+		}
+		std::string value = argv[++i];
+		if (arg == "--filter") {
+			filter = value;
+		} else if (arg == "--max-size") {
+			maxSize = std::atoi (value.c_str ());
+		} else if (arg == "--min-time") {
+			minTime = std::atof (value.c_str ());
+		} else if (arg == "--output") {
+			outputPath = value;
+		} else {
+			PrintUsage ();
+			return 1;
+		}
+	}
+
+	std::FILE* output = stdout;
+	if (!outputPath.empty ()) {
+		output = std::fopen (outputPath.c_str (), "w");
+		if (output == nullptr) {
+			std::fprintf (stderr, "Failed to open output file: %s\n", outputPath.c_str ());
+			return 1;
+		}
+	}
+
+	std::vector<BenchmarkResult> results;
+	bool arenaAllocated = false;
+	for (const Benchmark& benchmark : CreateBenchmarks ()) {
+		if (!filter.empty () && benchmark.name.find (filter) == std::string::npos) {
+			continue;
+		}
+		for (int size : benchmark.sizes) {
+			if (size > maxSize) {
+				continue;
+			}
+			BenchmarkResult result = RunBenchmark (benchmark, size, minTime);
+			std::fprintf (stderr, "%-48s %12.4f ms %14.0f cells/s %10.1f allocs %8.1f MB peak\n",
+				result.name.c_str (), result.realTimeMs, result.cellsPerSecond, result.allocationsPerIteration, result.peakRss / (1024.0 * 1024.0));
+			if (benchmark.name.find ("/arena") != std::string::npos && result.allocationsPerIteration > 0.0) {
+				std::fprintf (stderr, "%s made %.1f heap allocations per iteration\n", result.name.c_str (), result.allocationsPerIteration);
+				arenaAllocated = true;
+			}
+			results.push_back (result);
+		}
+	}
+
+	WriteJson (output, results);
+	if (output != stdout) {
+		std::fclose (output);
+	}
+	return arenaAllocated ? 1 : 0;
+}
@@ -0,0 +1,769 @@
+#include "MazeGenerator.hpp"
+#include "MazeAlgorithms.hpp"
+#include "MazeStreaming.hpp"
+#include "ParallelMazeGenerator.hpp"
+#include "PlacementPipeline.hpp"
+#include "WallPolylines.hpp"
+#include "MazeCache.hpp"
+#include "MazeFile.hpp"
+#include "WallBits.hpp"
+#include "MazeSolver.hpp"
+#include "MazeDistances.hpp"
+#include "MazeMetrics.hpp"
+#include "MazeBatch.hpp"
+#include "MazeRegion.hpp"
+#include "CellMask.hpp"
+#include "MazeBias.hpp"
+#include "LayeredMaze.hpp"
+#include "TopologyMaze.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+enum class GenerationMode
+{
+	Serial,
+	Parallel,
+	Stream,
+	Pipeline
+};
+
+class CommandLineOptions
+{
+public:
+	CommandLineOptions ();
+
+	int						rowCount;
+	int						colCount;
+	std::uint64_t			seed;
+	MG::MazeAlgorithmType	algorithm;
+	bool					algorithmSelected;
+	double					cellSize;
+	int						threadCount;
+	GenerationMode			mode;
+	std::string				outputPath;
+	std::string				cacheDirectory;
+	std::string				loadPath;
+	std::string				maskPath;
+	std::string				biasPath;
+	double					biasWeight;
+	std::string				savePath;
+	std::string				solutionPath;
+	bool					solve;
+	bool					diameter;
+	bool					metrics;
+	size_t					searchCount;
+	MG::MazeMetricType		searchMetric;
+	bool					searchMaximize;
+	int						layerCount;
+	MG::MazeTopologyType	topologyType;
+	size_t					batchCount;
+	std::string				batchDirectory;
+	bool					regenerateRegion;
+	MG::MazeRegion			region;
+	std::string				diffPath;
+	MG::MazeSolverType		solverType;
+	bool					polylines;
+	bool					quiet;
+};
+
+CommandLineOptions::CommandLineOptions () :
+	rowCount (10),
+	colCount (20),
+	seed (1),
+	algorithm (MG::MazeAlgorithmType::Prim),
+	algorithmSelected (false),
+	cellSize (1.0),
+	threadCount (0),
+	mode (GenerationMode::Serial),
+	outputPath (),
+	cacheDirectory (),
+	loadPath (),
+	maskPath (),
+	biasPath (),
+	biasWeight (16.0),
+	savePath (),
+	solutionPath (),
+	solve (false),
+	diameter (false),
+	metrics (false),
+	searchCount (0),
+	searchMetric (MG::MazeMetricType::SolutionLength),
+	searchMaximize (true),
+	layerCount (1),
+	topologyType (MG::MazeTopologyType::Square),
+	batchCount (0),
+	batchDirectory (),
+	regenerateRegion (false),
+	region (),
+	diffPath (),
+	solverType (MG::MazeSolverType::BreadthFirst),
+	polylines (false),
+	quiet (false)
+{
+
+}
+
+static void PrintUsage ()
+{
+	std::fprintf (stderr,
+		"Usage: maze-cli [options]\n"
+		"  --rows <count>         number of rows (default: 10)\n"
+		"  --cols <count>         number of columns (default: 20)\n"
+		"  --seed <value>         random seed (default: 1)\n"
+		"  --algorithm <name>     prim, kruskal, backtracker, wilson, eller, binarytree, sidewinder\n"
+		"  --cell-size <size>     cell dimension (default: 1.0)\n"
+		"  --mode <mode>          serial, parallel, stream or pipeline, stream always uses eller (default: serial)\n"
+		"  --threads <count>      worker threads, 0 means all cores (default: 0)\n"
+		"  --output <path>        geometry output file, - for stdout (default: no output)\n"
+		"  --geometry <type>      segments or polylines, polylines does not work in stream mode\n"
+		"  --cache-dir <path>     reuse mazes stored in this directory (serial mode)\n"
+		"  --load <path>          map a saved maze file instead of generating (serial mode)\n"
+		"  --mask <path>          generate only in the '.' cells of this text file (serial mode)\n"
+		"  --bias <path>          weighted prim, '-' and '|' in this text file favour horizontal and vertical corridors\n"
+		"  --bias-weight <value>  weight of a '-' or '|' corridor against other cells for --bias (default: 16)\n"
+		"  --save <path>          save the generated maze (serial or parallel mode)\n"
+		"  --solve <solver>       find the path from (0,0) to the last cell: bfs, astar, deadend\n"
+		"  --solution <path>      solution polyline output file, needs --solve\n"
+		"  --diameter             print the longest path of the maze and its endpoints\n"
+		"  --metrics              print dead ends, branching, river factor, solution length and longest corridor\n"
+		"  --search <count>       try this many seeds from --seed and keep the best one\n"
+		"  --maximize <metric>    metric for --search: deadends, branching, river, solution, corridor\n"
+		"  --minimize <metric>    like --maximize, but keep the seed with the lowest value\n"
+		"  --layers <count>       stack this many levels connected by stairs (serial or parallel mode)\n"
+		"  --topology <name>      square, hex, triangle or polar, the last three use kruskal (serial mode)\n"
+		"  --batch <count>        generate this many mazes from --seed on --threads workers\n"
+		"  --batch-dir <path>     save every batch maze into this directory, needs --batch\n"
+		"  --region <r,c,h,w>     regenerate the h x w cells at row r, column c after generation\n"
+		"  --diff <path>          write the walls removed (-) and added (+) by --region\n"
+		"  --quiet                do not print statistics\n"
+	);
+}
+
+static bool ParseCommandLine (int argc, char** argv, CommandLineOptions& options)
+{
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--quiet") {
+			options.quiet = true;
+			continue;
+		}
+		if (arg == "--diameter") {
+			options.diameter = true;
+			continue;
+		}
+		if (arg == "--metrics") {
+			options.metrics = true;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--rows") {
+			options.rowCount = std::atoi (value.c_str ());
+		} else if (arg == "--cols") {
+			options.colCount = std::atoi (value.c_str ());
+		} else if (arg == "--seed") {
+			options.seed = std::strtoull (value.c_str (), nullptr, 10);
+		} else if (arg == "--algorithm") {
+			if (!MG::FindMazeAlgorithmType (value, options.algorithm)) {
+				return false;
+			}
+			options.algorithmSelected = true;
+		} else if (arg == "--cell-size") {
+			options.cellSize = std::atof (value.c_str ());
+		} else if (arg == "--threads") {
+			options.threadCount = std::atoi (value.c_str ());
+		} else if (arg == "--mode") {
+			if (value == "serial") {
+				options.mode = GenerationMode::Serial;
+			} else if (value == "parallel") {
+				options.mode = GenerationMode::Parallel;
+			} else if (value == "stream") {
+				options.mode = GenerationMode::Stream;
+			} else if (value == "pipeline") {
+				options.mode = GenerationMode::Pipeline;
+			} else {
+				return false;
+			}
+		} else if (arg == "--output") {
+			options.outputPath = value;
+		} else if (arg == "--cache-dir") {
+			options.cacheDirectory = value;
+		} else if (arg == "--mask") {
+			options.maskPath = value;
+		} else if (arg == "--bias") {
+			options.biasPath = value;
+		} else if (arg == "--bias-weight") {
+			options.biasWeight = std::atof (value.c_str ());
+		} else if (arg == "--load") {
+			options.loadPath = value;
+		} else if (arg == "--save") {
+			options.savePath = value;
+		} else if (arg == "--solve") {
+			if (!MG::FindMazeSolverType (value, options.solverType)) {
+				return false;
+			}
+			options.solve = true;
+		} else if (arg == "--search") {
+			options.searchCount = (size_t) std::strtoull (value.c_str (), nullptr, 10);
+		} else if (arg == "--maximize" || arg == "--minimize") {
+			if (!MG::FindMazeMetricType (value, options.searchMetric)) {
+				return false;
+			}
+			options.searchMaximize = (arg == "--maximize");
+		} else if (arg == "--layers") {
+			options.layerCount = std::atoi (value.c_str ());
+		} else if (arg == "--topology") {
+			if (!MG::FindMazeTopologyType (value, options.topologyType)) {
+				return false;
+			}
+		} else if (arg == "--batch") {
+			options.batchCount = (size_t) std::strtoull (value.c_str (), nullptr, 10);
+		} else if (arg == "--batch-dir") {
+			options.batchDirectory = value;
+		} else if (arg == "--region") {
+			MG::MazeRegion& region = options.region;
+			if (std::sscanf (value.c_str (), "%d,%d,%d,%d", &region.begRow, &region.begCol, &region.rowCount, &region.colCount) != 4) {
+				return false;
+			}
+			options.regenerateRegion = true;
+		} else if (arg == "--diff") {
+			options.diffPath = value;
+		} else if (arg == "--solution") {
+			options.solutionPath = value;
+		} else if (arg == "--geometry") {
+			if (value == "segments") {
+				options.polylines = false;
+			} else if (value == "polylines") {
+				options.polylines = true;
+			} else {
+				return false;
+			}
+		} else {
+			return false;
+		}
+	}
+	if (options.mode == GenerationMode::Stream && options.algorithmSelected && options.algorithm != MG::MazeAlgorithmType::Eller) {
+		return false;
+	}
+	if (options.polylines && options.mode == GenerationMode::Stream) {
+		return false;
+	}
+	if (!options.loadPath.empty () && (options.mode != GenerationMode::Serial || !options.savePath.empty () || !options.cacheDirectory.empty ())) {
+		return false;
+	}
+	if (options.searchCount > 0 && !options.loadPath.empty ()) {
+		return false;
+	}
+	if ((!options.savePath.empty () || options.solve || options.diameter || options.metrics || options.searchCount > 0) && (options.mode == GenerationMode::Stream || options.mode == GenerationMode::Pipeline)) {
+		return false;
+	}
+	if (!options.solutionPath.empty () && !options.solve) {
+		return false;
+	}
+	if (!options.batchDirectory.empty () && options.batchCount == 0) {
+		return false;
+	}
+	if (!options.diffPath.empty () && !options.regenerateRegion) {
+		return false;
+	}
+	if (options.layerCount < 1) {
+		return false;
+	}
+	if (options.layerCount > 1 && (options.mode == GenerationMode::Stream || options.mode == GenerationMode::Pipeline || !options.loadPath.empty () ||
+		!options.cacheDirectory.empty () || !options.maskPath.empty () || !options.savePath.empty () || options.polylines || options.solve || options.diameter ||
+		options.metrics || options.searchCount > 0 || options.regenerateRegion || options.batchCount > 0)) {
+		return false;
+	}
+	if (options.topologyType != MG::MazeTopologyType::Square && (options.mode != GenerationMode::Serial || !options.loadPath.empty () ||
+		!options.cacheDirectory.empty () || !options.maskPath.empty () || !options.savePath.empty () || options.polylines || options.solve || options.diameter ||
+		options.metrics || options.searchCount > 0 || options.layerCount > 1 || options.regenerateRegion || options.batchCount > 0)) {
+		return false;
+	}
+	if (!options.biasPath.empty () && (options.mode != GenerationMode::Serial || options.algorithm != MG::MazeAlgorithmType::Prim || !options.loadPath.empty () ||
+		!options.cacheDirectory.empty () || !options.maskPath.empty () || options.searchCount > 0 || options.layerCount > 1 ||
+		options.topologyType != MG::MazeTopologyType::Square || options.batchCount > 0)) {
+		return false;
+	}
+	if (options.biasWeight <= 0.0) {
+		return false;
+	}
+	if (!options.maskPath.empty () && (options.mode != GenerationMode::Serial || !options.loadPath.empty () || !options.cacheDirectory.empty () ||
+		options.solve || options.diameter || options.metrics || options.searchCount > 0 || options.regenerateRegion || options.batchCount > 0)) {
+		return false;
+	}
+	if (options.regenerateRegion && (options.mode == GenerationMode::Stream || options.mode == GenerationMode::Pipeline || !options.loadPath.empty () || options.batchCount > 0)) {
+		return false;
+	}
+	if (options.batchCount > 0 && (options.mode != GenerationMode::Serial || !options.outputPath.empty () || !options.cacheDirectory.empty () || !options.loadPath.empty () ||
+		!options.savePath.empty () || options.solve || options.diameter || options.metrics || options.searchCount > 0)) {
+		return false;
+	}
+	return options.rowCount > 0 && options.colCount > 0;
+}
+
+static void WriteWallGeometries (std::FILE* output, const std::vector<MG::WallGeometry>& wallGeometries)
+{
+	if (output == nullptr) {
+		return;
+	}
+	for (const MG::WallGeometry& wall : wallGeometries) {
+		std::fprintf (output, "%g %g %g %g\n", wall.begX, wall.begY, wall.endX, wall.endY);
+	}
+}
+
+static void WriteWallPolylines (std::FILE* output, const MG::WallPolylines& wallPolylines)
+{
+	if (output == nullptr) {
+		return;
+	}
+	for (size_t i = 0; i < wallPolylines.GetPolylineCount (); i++) {
+		const MG::WallPoint* points = wallPolylines.GetPoints (i);
+		size_t pointCount = wallPolylines.GetPointCount (i);
+		for (size_t j = 0; j < pointCount; j++) {
+			std::fprintf (output, (j == 0 ? "%g %g" : " %g %g"), points[j].x, points[j].y);
+		}
+		std::fprintf (output, "\n");
+	}
+}
+
+class FileWallPlacementBackend : public MG::WallPlacementBackend
+{
+public:
+	FileWallPlacementBackend (std::FILE* output);
+
+	virtual bool	BeginPlacement (size_t wallCount) override;
+	virtual size_t	PlaceWalls (const MG::WallGeometry* walls, size_t wallCount) override;
+	virtual size_t	PlacePolylines (const MG::WallPolylines& polylines) override;
+
+private:
+	std::FILE*	output;
+};
+
+FileWallPlacementBackend::FileWallPlacementBackend (std::FILE* output) :
+	output (output)
+{
+
+}
+
+bool FileWallPlacementBackend::BeginPlacement (size_t)
+{
+	return true;
+}
+
+size_t FileWallPlacementBackend::PlaceWalls (const MG::WallGeometry* walls, size_t wallCount)
+{
+	WriteWallGeometries (output, std::vector<MG::WallGeometry> (walls, walls + wallCount));
+	return wallCount;
+}
+
+size_t FileWallPlacementBackend::PlacePolylines (const MG::WallPolylines& polylines)
+{
+	WriteWallPolylines (output, polylines);
+	return polylines.GetPolylineCount ();
+}
+
+static bool RunPlacementPipeline (const CommandLineOptions& options, std::FILE* output, size_t& wallCount)
+{
+	MG::PlacementPipeline pipeline (options.rowCount, options.colCount, options.seed, options.algorithm, options.cellSize);
+	pipeline.SetMergeWalls (options.polylines);
+	int lastPercent = -1;
+	if (!options.quiet) {
+		pipeline.SetProgressCallback ([&] (const MG::PlacementProgress& progress) {
+			int percent = (int) (progress.completedFraction * 100.0);
+			if (percent != lastPercent) {
+				std::fprintf (stderr, "\r%3d%% %zu walls", percent, progress.placedWallCount);
+				lastPercent = percent;
+			}
+		});
+	}
+
+	FileWallPlacementBackend backend (output);
+	MG::CancellationToken cancellationToken;
+	MG::PlacementResult result = pipeline.Run (backend, cancellationToken);
+	wallCount = result.placedWallCount;
+	if (!options.quiet) {
+		double waitMs = 0.0;
+		double placementMs = 0.0;
+		for (const MG::PlacementChunkStats& chunk : result.chunks) {
+			waitMs += chunk.waitMs;
+			placementMs += chunk.placementMs;
+		}
+		std::fprintf (stderr, "\n%zu chunks, generation %.1f ms, placement %.1f ms, waiting %.1f ms\n",
+			result.chunks.size (), result.generationMs, placementMs, waitMs);
+	}
+	return result.status == MG::PlacementStatus::Completed;
+}
+
+static bool SolveMazeFromEntrance (const CommandLineOptions& options, const MG::WallBitsView& wallBits)
+{
+	auto startTime = std::chrono::steady_clock::now ();
+	MG::MazeSolution solution = MG::SolveMaze (wallBits, 0, wallBits.rowCount * wallBits.colCount - 1, options.solverType);
+	double solveMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - startTime).count ();
+	if (!solution.found) {
+		std::fprintf (stderr, "No path found from the entrance to the exit.\n");
+		return false;
+	}
+	if (!options.quiet) {
+		std::fprintf (stderr, "%s: %zu cells on the path, %zu cells visited, %.1f MB working memory in %.1f ms\n",
+			MG::GetMazeSolverName (options.solverType), solution.cells.size (), solution.visitedCellCount, solution.memoryUsage / 1048576.0, solveMs);
+	}
+	if (options.solutionPath.empty ()) {
+		return true;
+	}
+	std::FILE* solutionOutput = std::fopen (options.solutionPath.c_str (), "w");
+	if (solutionOutput == nullptr) {
+		std::fprintf (stderr, "Failed to open solution file: %s\n", options.solutionPath.c_str ());
+		return false;
+	}
+	MG::WallPolylines solutionPolyline;
+	solutionPolyline.points = MG::GetSolutionPolyline (solution.cells, wallBits.colCount, options.cellSize);
+	solutionPolyline.polylineEnds.push_back (solutionPolyline.points.size ());
+	WriteWallPolylines (solutionOutput, solutionPolyline);
+	std::fclose (solutionOutput);
+	return true;
+}
+
+static void PrintMazeDiameter (const CommandLineOptions& options, const MG::WallBitsView& wallBits)
+{
+	auto startTime = std::chrono::steady_clock::now ();
+	MG::MazeDiameter diameter = MG::ComputeMazeDiameter (wallBits, options.threadCount);
+	double diameterMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - startTime).count ();
+	std::fprintf (stderr, "diameter: %u steps from (%d, %d) to (%d, %d) in %.1f ms\n", diameter.length,
+		diameter.begCellId / wallBits.colCount, diameter.begCellId % wallBits.colCount,
+		diameter.endCellId / wallBits.colCount, diameter.endCellId % wallBits.colCount, diameterMs);
+}
+
+static bool SaveMaze (const CommandLineOptions& options, const MG::Maze& maze)
+{
+	if (options.regenerateRegion || !options.maskPath.empty () || !options.biasPath.empty ()) {
+		return MG::WriteMazeFile (options.savePath, maze);
+	}
+	return MG::WriteMazeFile (options.savePath, maze, options.seed, options.algorithm);
+}
+
+static bool RegenerateRegion (const CommandLineOptions& options, MG::Maze& maze)
+{
+	auto startTime = std::chrono::steady_clock::now ();
+	MG::Xoshiro256Engine randomEngine (options.seed + 1);
+	MG::MazeWallDiff diff;
+	if (!MG::RegenerateMazeRegion (maze, options.region, randomEngine, options.cellSize, diff)) {
+		std::fprintf (stderr, "The region does not fit into the maze.\n");
+		return false;
+	}
+	double regenerateMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - startTime).count ();
+	if (!options.quiet) {
+		std::fprintf (stderr, "region: %zu wall slots changed, %zu walls removed, %zu walls added in %.2f ms\n",
+			diff.changedWallIds.size (), diff.removedWalls.size (), diff.addedWalls.size (), regenerateMs);
+	}
+	if (options.diffPath.empty ()) {
+		return true;
+	}
+	std::FILE* diffOutput = std::fopen (options.diffPath.c_str (), "w");
+	if (diffOutput == nullptr) {
+		std::fprintf (stderr, "Failed to open diff file: %s\n", options.diffPath.c_str ());
+		return false;
+	}
+	for (const MG::WallGeometry& wall : diff.removedWalls) {
+		std::fprintf (diffOutput, "- %g %g %g %g\n", wall.begX, wall.begY, wall.endX, wall.endY);
+	}
+	for (const MG::WallGeometry& wall : diff.addedWalls) {
+		std::fprintf (diffOutput, "+ %g %g %g %g\n", wall.begX, wall.begY, wall.endX, wall.endY);
+	}
+	std::fclose (diffOutput);
+	return true;
+}
+
+static void PrintMazeMetrics (const MG::MazeMetrics& metrics)
+{
+	std::fprintf (stderr, "metrics: %zu dead ends, branching %.4f, river %.4f, solution %zu cells, longest corridor %zu\n",
+		metrics.deadEndCount, metrics.branchingFactor, metrics.riverFactor, metrics.solutionLength, metrics.longestCorridor);
+}
+
+static void SearchMazeSeed (CommandLineOptions& options)
+{
+	auto startTime = std::chrono::steady_clock::now ();
+	MG::MazeSeedSearchResult result = MG::FindBestMazeSeed (options.rowCount, options.colCount, options.algorithm, options.seed, options.searchCount,
+		options.searchMetric, options.searchMaximize, options.threadCount);
+	double searchMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - startTime).count ();
+	if (!options.quiet) {
+		std::fprintf (stderr, "search: seed %llu has the %s %s of %zu candidates (%g) in %.1f ms\n",
+			(unsigned long long) result.seed, (options.searchMaximize ? "highest" : "lowest"), MG::GetMazeMetricName (options.searchMetric),
+			result.candidateCount, MG::GetMazeMetricValue (result.metrics, options.searchMetric), searchMs);
+	}
+	options.seed = result.seed;
+}
+
+static bool GenerateLayeredMaze (const CommandLineOptions& options, std::FILE* output, size_t& wallCount)
+{
+	auto startTime = std::chrono::steady_clock::now ();
+	MG::LayeredMazeGenerator generator (options.layerCount, options.rowCount, options.colCount, options.seed, options.threadCount, options.algorithm);
+	if (!generator.Generate ()) {
+		return false;
+	}
+	auto generatedTime = std::chrono::steady_clock::now ();
+	const MG::LayeredMaze& maze = generator.GetMaze ();
+	MG::LayeredMazeGeometry geometry = maze.GetGeometry (options.cellSize, options.threadCount);
+	auto extractedTime = std::chrono::steady_clock::now ();
+
+	wallCount = 0;
+	for (int layer = 0; layer < maze.GetLayerCount (); layer++) {
+		if (output != nullptr) {
+			std::fprintf (output, "layer %d\n", layer);
+		}
+		WriteWallGeometries (output, geometry.layerWalls[layer]);
+		wallCount += geometry.layerWalls[layer].size ();
+	}
+	if (output != nullptr) {
+		for (const MG::MazeConnector& connector : geometry.connectors) {
+			std::fprintf (output, "connector %d %g %g\n", connector.lowerLayer, connector.x, connector.y);
+		}
+	}
+	if (!options.quiet) {
+		std::fprintf (stderr, "layers: %d levels, %zu connectors, generated in %.1f ms, geometry extracted in %.1f ms\n",
+			maze.GetLayerCount (), geometry.connectors.size (),
+			std::chrono::duration<double, std::milli> (generatedTime - startTime).count (),
+			std::chrono::duration<double, std::milli> (extractedTime - generatedTime).count ());
+	}
+	return true;
+}
+
+static size_t WriteTopologyGeometry (std::FILE* output, const std::vector<MG::WallGeometry>& wallGeometries)
+{
+	WriteWallGeometries (output, wallGeometries);
+	return wallGeometries.size ();
+}
+
+static size_t WriteTopologyGeometry (std::FILE* output, const MG::WallPolylines& wallPolylines)
+{
+	WriteWallPolylines (output, wallPolylines);
+	return wallPolylines.GetPolylineCount ();
+}
+
+static size_t WriteTopologyGeometry (std::FILE* output, const MG::PolarWallGeometry& wallGeometry)
+{
+	WriteWallGeometries (output, wallGeometry.radialWalls);
+	if (output != nullptr) {
+		for (const MG::WallArc& arc : wallGeometry.arcWalls) {
+			std::fprintf (output, "arc %g %g %g %g %g\n", arc.centerX, arc.centerY, arc.radius, arc.begAngle, arc.endAngle);
+		}
+	}
+	return wallGeometry.radialWalls.size () + wallGeometry.arcWalls.size ();
+}
+
+template <typename Topology>
+static bool GenerateTopologyMaze (const CommandLineOptions& options, std::FILE* output, size_t& wallCount)
+{
+	auto startTime = std::chrono::steady_clock::now ();
+	MG::TopologyMaze<Topology> maze (options.rowCount, options.colCount);
+	MG::Xoshiro256Engine randomEngine (options.seed);
+	if (!maze.Generate (randomEngine)) {
+		std::fprintf (stderr, "The %s grid cells are not connected.\n", Topology::GetName ());
+		return false;
+	}
+	auto generatedTime = std::chrono::steady_clock::now ();
+	wallCount = WriteTopologyGeometry (output, maze.GetWallGeometries (options.cellSize));
+	if (!options.quiet) {
+		std::fprintf (stderr, "%s: %d cells, %zu wall edges, generated in %.1f ms\n", Topology::GetName (), maze.GetCellCount (), maze.GetWallCount (),
+			std::chrono::duration<double, std::milli> (generatedTime - startTime).count ());
+	}
+	return true;
+}
+
+static bool GenerateMazeBatch (const CommandLineOptions& options)
+{
+	std::vector<MG::MazeBatchJob> jobs;
+	for (size_t jobIndex = 0; jobIndex < options.batchCount; jobIndex++) {
+		jobs.push_back (MG::MazeBatchJob (options.rowCount, options.colCount, options.seed + jobIndex, options.algorithm));
+	}
+
+	size_t failedCount = 0;
+	MG::MazeBatchGenerator batchGenerator (options.threadCount);
+	MG::MazeBatchStats stats = batchGenerator.Run (jobs, [&] (MG::MazeBatchResult& result) {
+		const MG::MazeBatchJob& job = jobs[result.jobIndex];
+		if (result.succeeded && !options.batchDirectory.empty ()) {
+			std::string path = options.batchDirectory + "/" + MG::GetMazeAlgorithmName (job.algorithmType) + "_" + std::to_string (job.seed) + ".mgwb";
+			result.succeeded = MG::WriteMazeFile (path, result.maze, job.seed, job.algorithmType);
+		}
+		if (!result.succeeded) {
+			failedCount += 1;
+		}
+		return true;
+	});
+
+	if (!options.quiet) {
+		std::fprintf (stderr, "batch: %zu %dx%d %s mazes on %d workers (%zu stolen jobs) in %.1f ms, %.1f mazes/s\n",
+			stats.completedJobCount, options.rowCount, options.colCount, MG::GetMazeAlgorithmName (options.algorithm), stats.workerCount,
+			stats.stolenJobCount, stats.totalMs, stats.totalMs > 0.0 ? stats.completedJobCount * 1000.0 / stats.totalMs : 0.0);
+	}
+	if (failedCount > 0) {
+		std::fprintf (stderr, "Batch generation failed for %zu mazes.\n", failedCount);
+		return false;
+	}
+	return true;
+}
+
+int main (int argc, char** argv)
+{
+	CommandLineOptions options;
+	if (!ParseCommandLine (argc, argv, options)) {
+		PrintUsage ();
+		return 1;
+	}
+	if (options.batchCount > 0) {
+		return GenerateMazeBatch (options) ? 0 : 1;
+	}
+
+	std::FILE* output = nullptr;
+	if (options.outputPath == "-") {
+		output = stdout;
+	} else if (!options.outputPath.empty ()) {
+		output = std::fopen (options.outputPath.c_str (), "w");
+		if (output == nullptr) {
+			std::fprintf (stderr, "Failed to open output file: %s\n", options.outputPath.c_str ());
+			return 1;
+		}
+	}
+
+	if (options.searchCount > 0) {
+		SearchMazeSeed (options);
+	}
+
+	auto startTime = std::chrono::steady_clock::now ();
+	size_t wallCount = 0;
+	bool succeeded = false;
+	if (options.mode == GenerationMode::Stream) {
+		MG::StreamingMazeGenerator generator (options.rowCount, options.colCount, options.seed);
+		succeeded = generator.Generate (options.cellSize, [&] (int, const std::vector<MG::WallGeometry>& finishedWalls) {
+			WriteWallGeometries (output, finishedWalls);
+			wallCount += finishedWalls.size ();
+			return true;
+		});
+	} else if (options.mode == GenerationMode::Pipeline) {
+		succeeded = RunPlacementPipeline (options, output, wallCount);
+	} else if (options.layerCount > 1) {
+		succeeded = GenerateLayeredMaze (options, output, wallCount);
+	} else if (options.topologyType == MG::MazeTopologyType::Hex) {
+		succeeded = GenerateTopologyMaze<MG::HexTopology> (options, output, wallCount);
+	} else if (options.topologyType == MG::MazeTopologyType::Triangle) {
+		succeeded = GenerateTopologyMaze<MG::TriangleTopology> (options, output, wallCount);
+	} else if (options.topologyType == MG::MazeTopologyType::Polar) {
+		succeeded = GenerateTopologyMaze<MG::PolarTopology> (options, output, wallCount);
+	} else {
+		MG::Maze maze;
+		MG::MappedMazeFile mappedFile;
+		if (!options.loadPath.empty ()) {
+			if (!mappedFile.Open (options.loadPath, true)) {
+				std::fprintf (stderr, "Failed to load maze file: %s\n", options.loadPath.c_str ());
+				return 1;
+			}
+			succeeded = true;
+			const MG::MazeFileHeader& header = mappedFile.GetHeader ();
+			options.rowCount = header.rowCount;
+			options.colCount = header.colCount;
+			options.seed = header.seed;
+			if (header.algorithmType >= 0 && header.algorithmType < (std::int32_t) MG::GetAllMazeAlgorithmTypes ().size ()) {
+				options.algorithm = (MG::MazeAlgorithmType) header.algorithmType;
+			}
+			if (!options.quiet) {
+				double loadMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - startTime).count ();
+				std::fprintf (stderr, "mapped %s in %.2f ms\n", options.loadPath.c_str (), loadMs);
+			}
+		} else if (options.mode == GenerationMode::Parallel) {
+			MG::ParallelMazeGenerator generator (options.rowCount, options.colCount, options.seed, options.threadCount, options.algorithm);
+			succeeded = generator.Generate ();
+			maze = generator.GetMaze ();
+		} else if (!options.maskPath.empty ()) {
+			MG::CellMask cellMask;
+			if (!MG::ReadCellMaskFile (options.maskPath, cellMask)) {
+				std::fprintf (stderr, "Failed to read mask file: %s\n", options.maskPath.c_str ());
+				return 1;
+			}
+			options.rowCount = cellMask.GetRowCount ();
+			options.colCount = cellMask.GetColCount ();
+			MG::MazeGenerator generator (cellMask, options.seed, options.algorithm);
+			succeeded = generator.Generate ();
+			maze = generator.GetMaze ();
+			if (!succeeded) {
+				std::fprintf (stderr, "The mask cells are not connected or %s does not support masks.\n", MG::GetMazeAlgorithmName (options.algorithm));
+			}
+		} else if (!options.biasPath.empty ()) {
+			MG::MazeBiasField biasField;
+			if (!MG::ReadMazeBiasFile (options.biasPath, options.rowCount, options.colCount, options.biasWeight, biasField)) {
+				std::fprintf (stderr, "Failed to read bias file: %s\n", options.biasPath.c_str ());
+				return 1;
+			}
+			MG::MazeGenerator generator (biasField, options.seed);
+			succeeded = generator.Generate ();
+			maze = generator.GetMaze ();
+		} else if (!options.cacheDirectory.empty ()) {
+			MG::MazeCache mazeCache;
+			mazeCache.SetDiskDirectory (options.cacheDirectory);
+			std::shared_ptr<const MG::Maze> cachedMaze = mazeCache.GetMaze (MG::MazeCacheKey (options.rowCount, options.colCount, options.seed, options.algorithm));
+			succeeded = (cachedMaze != nullptr);
+			if (succeeded) {
+				maze = *cachedMaze;
+			}
+			if (!options.quiet) {
+				MG::MazeCacheStats stats = mazeCache.GetStats ();
+				std::fprintf (stderr, "cache: %zu disk hits, %zu misses\n", stats.diskHitCount, stats.missCount);
+			}
+		} else {
+			MG::MazeGenerator generator (options.rowCount, options.colCount, options.seed, options.algorithm);
+			succeeded = generator.Generate ();
+			maze = generator.GetMaze ();
+		}
+		if (succeeded && options.regenerateRegion) {
+			succeeded = RegenerateRegion (options, maze);
+		}
+		if (succeeded && !options.savePath.empty () && !SaveMaze (options, maze)) {
+			std::fprintf (stderr, "Failed to save maze file: %s\n", options.savePath.c_str ());
+			succeeded = false;
+		}
+		MG::WallBitsView wallBits = (mappedFile.IsOpen () ? mappedFile.GetWallBits () : maze.GetWallBits ());
+		std::vector<MG::WallGeometry> wallGeometries = MG::ExtractWallGeometries (wallBits, options.cellSize, options.threadCount);
+		wallCount = wallGeometries.size ();
+		if (options.polylines) {
+			MG::WallPolylines wallPolylines = MG::TraceWallPolylines (wallBits, options.cellSize);
+			WriteWallPolylines (output, wallPolylines);
+			if (!options.quiet && wallCount > 0) {
+				std::fprintf (stderr, "%zu straight walls traced into %zu polylines (%.1f%% fewer elements)\n",
+					wallCount, wallPolylines.GetPolylineCount (), 100.0 - 100.0 * wallPolylines.GetPolylineCount () / wallCount);
+			}
+			wallCount = wallPolylines.GetPolylineCount ();
+		} else {
+			WriteWallGeometries (output, wallGeometries);
+		}
+		if (succeeded && options.solve) {
+			succeeded = SolveMazeFromEntrance (options, wallBits);
+		}
+		if (succeeded && options.diameter) {
+			PrintMazeDiameter (options, wallBits);
+		}
+		if (succeeded && options.metrics) {
+			PrintMazeMetrics (MG::ComputeMazeMetrics (wallBits));
+		}
+	}
+	double elapsedMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - startTime).count ();
+
+	if (output != nullptr && output != stdout) {
+		std::fclose (output);
+	}
+	if (!succeeded) {
+		std::fprintf (stderr, "Maze generation failed.\n");
+		return 1;
+	}
+	if (!options.quiet) {
+		const char* algorithmName = (options.mode == GenerationMode::Stream ? "eller" : MG::GetMazeAlgorithmName (options.algorithm));
+		if (options.topologyType != MG::MazeTopologyType::Square) {
+			algorithmName = "kruskal";
+		}
+		std::fprintf (stderr, "%dx%d %s seed=%llu: %zu walls in %.1f ms\n",
+			options.rowCount, options.colCount, algorithmName, (unsigned long long) options.seed, wallCount, elapsedMs);
+	}
+	return 0;
+}
@@ -0,0 +1,271 @@
+#include "CellMask.hpp"
+#include "WallBits.hpp"
+#include "TextFile.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace MG
+{
+
+class MaskRun
+{
+public:
+	MaskRun (int beg, int end, int id);
+
+	int		beg;
+	int		end;
+	int		id;
+};
+
+MaskRun::MaskRun (int beg, int end, int id) :
+	beg (beg),
+	end (end),
+	id (id)
+{
+
+}
+
+static int FindRunSet (std::vector<int>& parents, int runId)
+{
+	while (parents[runId] != runId) {
+		parents[runId] = parents[parents[runId]];
+		runId = parents[runId];
+	}
+	return runId;
+}
+
+CellMask::CellMask () :
+	rows (0),
+	cols (0),
+	wordsPerRow (0),
+	activeCellCount (0),
+	bits ()
+{
+
+}
+
+CellMask::CellMask (int rowCount, int colCount, bool active) :
+	CellMask ()
+{
+	Reset (rowCount, colCount, active);
+}
+
+void CellMask::Reset (int rowCount, int colCount, bool active)
+{
+	rows = std::max (rowCount, 0);
+	cols = std::max (colCount, 0);
+	wordsPerRow = (cols + WallWordBits - 1) / WallWordBits;
+	activeCellCount = 0;
+	bits.assign ((size_t) rows * wordsPerRow, 0);
+	if (!active) {
+		return;
+	}
+	for (int row = 0; row < rows; row++) {
+		for (int col = 0; col < cols; col += WallWordBits) {
+			int bitCount = std::min (cols - col, WallWordBits);
+			bits[(size_t) row * wordsPerRow + col / WallWordBits] = (bitCount == WallWordBits ? ~(std::uint64_t) 0 : ((std::uint64_t) 1 << bitCount) - 1);
+		}
+	}
+	activeCellCount = rows * cols;
+}
+
+void CellMask::SetCellActive (int row, int col, bool active)
+{
+	if (row < 0 || row >= rows || col < 0 || col >= cols) {
+		return;
+	}
+	std::uint64_t& word = bits[(size_t) row * wordsPerRow + col / WallWordBits];
+	std::uint64_t mask = (std::uint64_t) 1 << (col % WallWordBits);
+	if (((word & mask) != 0) == active) {
+		return;
+	}
+	word ^= mask;
+	activeCellCount += (active ? 1 : -1);
+}
+
+int CellMask::GetRowCount () const
+{
+	return rows;
+}
+
+int CellMask::GetColCount () const
+{
+	return cols;
+}
+
+int CellMask::GetWordsPerRow () const
+{
+	return wordsPerRow;
+}
+
+int CellMask::GetActiveCellCount () const
+{
+	return activeCellCount;
+}
+
+bool CellMask::IsFull () const
+{
+	return activeCellCount == rows * cols;
+}
+
+bool CellMask::IsCellActive (int row, int col) const
+{
+	if (row < 0 || row >= rows || col < 0 || col >= cols) {
+		return false;
+	}
+	return ((bits[(size_t) row * wordsPerRow + col / WallWordBits] >> (col % WallWordBits)) & 1) != 0;
+}
+
+const std::uint64_t* CellMask::GetRowBits (int row) const
+{
+	return bits.data () + (size_t) row * wordsPerRow;
+}
+
+CellId CellMask::FindFirstActiveCell () const
+{
+	for (size_t wordIndex = 0; wordIndex < bits.size (); wordIndex++) {
+		if (bits[wordIndex] != 0) {
+			int row = (int) (wordIndex / wordsPerRow);
+			int col = (int) (wordIndex % wordsPerRow) * WallWordBits + CountTrailingZeros (bits[wordIndex]);
+			return row * cols + col;
+		}
+	}
+	return InvalidCellId;
+}
+
+CellId CellMask::FindLastActiveCell () const
+{
+	for (size_t wordIndex = bits.size (); wordIndex > 0; wordIndex--) {
+		std::uint64_t word = bits[wordIndex - 1];
+		if (word != 0) {
+			int highestBit = WallWordBits - 1 - CountLeadingZeros (word);
+			int row = (int) ((wordIndex - 1) / wordsPerRow);
+			int col = (int) ((wordIndex - 1) % wordsPerRow) * WallWordBits + highestBit;
+			return row * cols + col;
+		}
+	}
+	return InvalidCellId;
+}
+
+CellMaskIndex::CellMaskIndex (MemoryArena* arena) :
+	cellMask (nullptr),
+	wordRanks (ArenaAllocator<int> (arena)),
+	cellIds (ArenaAllocator<CellId> (arena))
+{
+
+}
+
+void CellMaskIndex::Build (const CellMask& newCellMask)
+{
+	cellMask = &newCellMask;
+	int rows = cellMask->GetRowCount ();
+	int cols = cellMask->GetColCount ();
+	int wordsPerRow = cellMask->GetWordsPerRow ();
+	wordRanks.resize ((size_t) rows * wordsPerRow);
+	cellIds.clear ();
+	cellIds.reserve (cellMask->GetActiveCellCount ());
+	for (int row = 0; row < rows; row++) {
+		const std::uint64_t* rowBits = cellMask->GetRowBits (row);
+		for (int wordIndex = 0; wordIndex < wordsPerRow; wordIndex++) {
+			wordRanks[(size_t) row * wordsPerRow + wordIndex] = (int) cellIds.size ();
+			std::uint64_t word = rowBits[wordIndex];
+			while (word != 0) {
+				cellIds.push_back (row * cols + wordIndex * WallWordBits + CountTrailingZeros (word));
+				word &= word - 1;
+			}
+		}
+	}
+}
+
+int CellMaskIndex::GetActiveCellCount () const
+{
+	return (int) cellIds.size ();
+}
+
+int CellMaskIndex::GetCellIndex (CellId cellId) const
+{
+	if (cellId == InvalidCellId) {
+		return -1;
+	}
+	int cols = cellMask->GetColCount ();
+	int row = cellId / cols;
+	int col = cellId % cols;
+	size_t wordIndex = (size_t) row * cellMask->GetWordsPerRow () + col / WallWordBits;
+	std::uint64_t word = cellMask->GetRowBits (row)[col / WallWordBits];
+	int bit = col % WallWordBits;
+	if (((word >> bit) & 1) == 0) {
+		return -1;
+	}
+	return wordRanks[wordIndex] + CountBits (word & (((std::uint64_t) 1 << bit) - 1));
+}
+
+CellId CellMaskIndex::GetCellId (int cellIndex) const
+{
+	return cellIds[cellIndex];
+}
+
+bool IsCellMaskConnected (const CellMask& cellMask)
+{
+	if (cellMask.GetActiveCellCount () == 0) {
+		return false;
+	}
+
+	std::vector<int> parents;
+	std::vector<MaskRun> previousRuns;
+	std::vector<MaskRun> currentRuns;
+	int setCount = 0;
+	for (int row = 0; row < cellMask.GetRowCount (); row++) {
+		currentRuns.clear ();
+		EnumerateBitRuns (cellMask.GetRowBits (row), cellMask.GetWordsPerRow (), cellMask.GetColCount (), [&] (int beg, int end) {
+			currentRuns.push_back (MaskRun (beg, end, (int) parents.size ()));
+			parents.push_back ((int) parents.size ());
+			setCount += 1;
+		});
+
+		size_t previousIndex = 0;
+		for (const MaskRun& run : currentRuns) {
+			while (previousIndex < previousRuns.size () && previousRuns[previousIndex].end <= run.beg) {
+				previousIndex++;
+			}
+			for (size_t index = previousIndex; index < previousRuns.size () && previousRuns[index].beg < run.end; index++) {
+				int root1 = FindRunSet (parents, previousRuns[index].id);
+				int root2 = FindRunSet (parents, run.id);
+				if (root1 != root2) {
+					parents[root2] = root1;
+					setCount -= 1;
+				}
+			}
+		}
+		std::swap (previousRuns, currentRuns);
+	}
+	return setCount == 1;
+}
+
+bool ReadCellMaskFile (const std::string& path, CellMask& cellMask)
+{
+	std::vector<std::string> lines;
+	if (!ReadTextLines (path, lines)) {
+		return false;
+	}
+
+	size_t colCount = 0;
+	for (const std::string& line : lines) {
+		colCount = std::max (colCount, line.size ());
+	}
+	if (lines.empty () || colCount == 0) {
+		return false;
+	}
+
+	cellMask.Reset ((int) lines.size (), (int) colCount, false);
+	for (size_t row = 0; row < lines.size (); row++) {
+		for (size_t col = 0; col < lines[row].size (); col++) {
+			if (lines[row][col] == '.') {
+				cellMask.SetCellActive ((int) row, (int) col, true);
+			}
+		}
+	}
+	return true;
+}
+
+}
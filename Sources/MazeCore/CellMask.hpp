@@ -0,0 +1,61 @@
+#ifndef CELLMASK_HPP
+#define CELLMASK_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <string>
+
+namespace MG
+{
+
+class CellMask
+{
+public:
+	CellMask ();
+	CellMask (int rowCount, int colCount, bool active);
+
+	void					Reset (int rowCount, int colCount, bool active);
+	void					SetCellActive (int row, int col, bool active);
+
+	int						GetRowCount () const;
+	int						GetColCount () const;
+	int						GetWordsPerRow () const;
+	int						GetActiveCellCount () const;
+	bool					IsFull () const;
+	bool					IsCellActive (int row, int col) const;
+	const std::uint64_t*	GetRowBits (int row) const;
+
+	CellId					FindFirstActiveCell () const;
+	CellId					FindLastActiveCell () const;
+
+private:
+	int							rows;
+	int							cols;
+	int							wordsPerRow;
+	int							activeCellCount;
+	std::vector<std::uint64_t>	bits;
+};
+
+class CellMaskIndex
+{
+public:
+	explicit CellMaskIndex (MemoryArena* arena = nullptr);
+
+	void	Build (const CellMask& cellMask);
+
+	int		GetActiveCellCount () const;
+	int		GetCellIndex (CellId cellId) const;
+	CellId	GetCellId (int cellIndex) const;
+
+private:
+	const CellMask*		cellMask;
+	ArenaVector<int>	wordRanks;
+	ArenaVector<CellId>	cellIds;
+};
+
+bool	IsCellMaskConnected (const CellMask& cellMask);
+bool	ReadCellMaskFile (const std::string& path, CellMask& cellMask);
+
+}
+
+#endif
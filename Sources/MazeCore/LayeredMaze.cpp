@@ -0,0 +1,320 @@
+#include "LayeredMaze.hpp"
+#include "MazeAlgorithms.hpp"
+#include "Parallel.hpp"
+#include "WallBits.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace MG
+{
+
+MazeConnector::MazeConnector () :
+	MazeConnector (0, 0.0, 0.0)
+{
+
+}
+
+MazeConnector::MazeConnector (int lowerLayer, double x, double y) :
+	lowerLayer (lowerLayer),
+	x (x),
+	y (y)
+{
+
+}
+
+LayeredMazeGeometry::LayeredMazeGeometry () :
+	layerWalls (),
+	connectors ()
+{
+
+}
+
+LayeredMaze::LayeredMaze () :
+	layers (0),
+	rows (0),
+	cols (0),
+	connectorWordsPerRow (0),
+	layerMazes (),
+	connectorBits ()
+{
+
+}
+
+LayeredMaze::LayeredMaze (int layerCount, int rowCount, int colCount) :
+	LayeredMaze ()
+{
+	Reset (layerCount, rowCount, colCount);
+}
+
+void LayeredMaze::Reset (int layerCount, int rowCount, int colCount)
+{
+	layers = std::max (layerCount, 0);
+	rows = std::max (rowCount, 0);
+	cols = std::max (colCount, 0);
+	connectorWordsPerRow = (cols + WallWordBits - 1) / WallWordBits;
+	layerMazes.resize (layers);
+	for (Maze& layerMaze : layerMazes) {
+		layerMaze.Reset (rows, cols);
+	}
+	connectorBits.assign ((size_t) std::max (layers - 1, 0) * rows * connectorWordsPerRow, 0);
+}
+
+int LayeredMaze::GetLayerCount () const
+{
+	return layers;
+}
+
+int LayeredMaze::GetRowCount () const
+{
+	return rows;
+}
+
+int LayeredMaze::GetColCount () const
+{
+	return cols;
+}
+
+const Maze& LayeredMaze::GetLayer (int layer) const
+{
+	return layerMazes[layer];
+}
+
+Maze& LayeredMaze::GetLayer (int layer)
+{
+	return layerMazes[layer];
+}
+
+bool LayeredMaze::HasPassage (int layer, int row, int col, Direction dir) const
+{
+	if (layer < 0 || layer >= layers) {
+		return false;
+	}
+	switch (dir) {
+	case Direction::Up:
+		return HasConnector (layer, row, col);
+	case Direction::Down:
+		return HasConnector (layer - 1, row, col);
+	default:
+		break;
+	}
+	const Maze& layerMaze = layerMazes[layer];
+	CellId cellId = layerMaze.GetCellId (row, col);
+	if (cellId == InvalidCellId || layerMaze.GetNeighbourCellId (cellId, dir) == InvalidCellId) {
+		return false;
+	}
+	return layerMaze.GetWallId (row, col, dir) == InvalidWallId;
+}
+
+bool LayeredMaze::HasConnector (int lowerLayer, int row, int col) const
+{
+	if (lowerLayer < 0 || lowerLayer + 1 >= layers || row < 0 || row >= rows || col < 0 || col >= cols) {
+		return false;
+	}
+	return ((GetConnectorRow (lowerLayer, row)[col / WallWordBits] >> (col % WallWordBits)) & 1) != 0;
+}
+
+void LayeredMaze::AddConnector (int lowerLayer, int row, int col)
+{
+	if (lowerLayer < 0 || lowerLayer + 1 >= layers || row < 0 || row >= rows || col < 0 || col >= cols) {
+		return;
+	}
+	size_t wordIndex = ((size_t) lowerLayer * rows + row) * connectorWordsPerRow + col / WallWordBits;
+	connectorBits[wordIndex] |= (std::uint64_t) 1 << (col % WallWordBits);
+}
+
+size_t LayeredMaze::GetConnectorCount () const
+{
+	size_t connectorCount = 0;
+	for (std::uint64_t word : connectorBits) {
+		connectorCount += CountBits (word);
+	}
+	return connectorCount;
+}
+
+LayeredMazeGeometry LayeredMaze::GetGeometry (double cellSize, int threadCount) const
+{
+	LayeredMazeGeometry geometry;
+	geometry.layerWalls.resize (layers);
+	ParallelFor (layers, threadCount, [&] (int layer, int) {
+		geometry.layerWalls[layer] = ExtractWallGeometries (layerMazes[layer].GetWallBits (), cellSize, 1);
+	});
+
+	geometry.connectors.reserve (GetConnectorCount ());
+	for (int lowerLayer = 0; lowerLayer + 1 < layers; lowerLayer++) {
+		for (int row = 0; row < rows; row++) {
+			const std::uint64_t* connectorRow = GetConnectorRow (lowerLayer, row);
+			for (int wordIndex = 0; wordIndex < connectorWordsPerRow; wordIndex++) {
+				std::uint64_t word = connectorRow[wordIndex];
+				while (word != 0) {
+					int col = wordIndex * WallWordBits + CountTrailingZeros (word);
+					geometry.connectors.push_back (MazeConnector (lowerLayer, (col + 0.5) * cellSize, (row + 0.5) * cellSize));
+					word &= word - 1;
+				}
+			}
+		}
+	}
+	return geometry;
+}
+
+const std::uint64_t* LayeredMaze::GetConnectorRow (int lowerLayer, int row) const
+{
+	return connectorBits.data () + ((size_t) lowerLayer * rows + row) * connectorWordsPerRow;
+}
+
+LayeredMazeGenerator::LayeredMazeGenerator (int layerCount, int rowCount, int colCount, std::uint64_t seed, int threadCount, MazeAlgorithmType algorithmType) :
+	maze (),
+	layerCount (layerCount),
+	rowCount (rowCount),
+	colCount (colCount),
+	seed (seed),
+	threadCount (threadCount),
+	algorithmType (algorithmType),
+	tileSize (DefaultTileSize),
+	tileRowCount (0),
+	tileColCount (0)
+{
+
+}
+
+void LayeredMazeGenerator::SetTileSize (int newTileSize)
+{
+	int wordCount = std::max ((newTileSize + WallWordBits - 1) / WallWordBits, 1);
+	tileSize = wordCount * WallWordBits;
+}
+
+int LayeredMazeGenerator::GetTileSize () const
+{
+	return tileSize;
+}
+
+bool LayeredMazeGenerator::Generate ()
+{
+	if (layerCount <= 0 || rowCount <= 0 || colCount <= 0) {
+		return false;
+	}
+
+	maze.Reset (layerCount, rowCount, colCount);
+	tileRowCount = (rowCount + tileSize - 1) / tileSize;
+	tileColCount = (colCount + tileSize - 1) / tileSize;
+	int blockCount = layerCount * tileRowCount * tileColCount;
+
+	int workerCount = GetEffectiveThreadCount (threadCount, blockCount);
+	std::vector<Maze> tileMazes (workerCount);
+	std::vector<std::unique_ptr<MazeAlgorithm>> tileAlgorithms;
+	for (int i = 0; i < workerCount; i++) {
+		tileAlgorithms.push_back (CreateMazeAlgorithm (algorithmType));
+		if (tileAlgorithms.back () == nullptr) {
+			return false;
+		}
+	}
+
+	ParallelFor (blockCount, workerCount, [&] (int blockIndex, int threadIndex) {
+		GenerateTile (blockIndex, tileMazes[threadIndex], *tileAlgorithms[threadIndex]);
+	});
+	ConnectBlocks ();
+
+	Maze& firstLayer = maze.GetLayer (0);
+	Maze& lastLayer = maze.GetLayer (layerCount - 1);
+	firstLayer.RemoveWall (firstLayer.GetWallId (0, 0, Direction::Top));
+	lastLayer.RemoveWall (lastLayer.GetWallId (rowCount - 1, colCount - 1, Direction::Bottom));
+
+	return true;
+}
+
+const LayeredMaze& LayeredMazeGenerator::GetMaze () const
+{
+	return maze;
+}
+
+void LayeredMazeGenerator::GenerateTile (int blockIndex, Maze& tileMaze, MazeAlgorithm& tileAlgorithm)
+{
+	int tilesPerLayer = tileRowCount * tileColCount;
+	int tileIndex = blockIndex % tilesPerLayer;
+	int begRow = (tileIndex / tileColCount) * tileSize;
+	int begCol = (tileIndex % tileColCount) * tileSize;
+	int tileRows = std::min (tileSize, rowCount - begRow);
+	int tileCols = std::min (tileSize, colCount - begCol);
+
+	Xoshiro256Engine tileRandomEngine (DeriveSeed (seed, (std::uint64_t) blockIndex + 1));
+	tileMaze.Reset (tileRows, tileCols);
+	tileAlgorithm.Generate (tileMaze, tileRandomEngine);
+
+	Maze& layerMaze = maze.GetLayer (blockIndex / tilesPerLayer);
+	layerMaze.CopyTileWalls (tileMaze, begRow, begCol);
+}
+
+void LayeredMazeGenerator::ConnectBlocks ()
+{
+	int tilesPerLayer = tileRowCount * tileColCount;
+	int blockCount = layerCount * tilesPerLayer;
+	std::vector<int> parents (blockCount);
+	for (int blockIndex = 0; blockIndex < blockCount; blockIndex++) {
+		parents[blockIndex] = blockIndex;
+	}
+	auto findSet = [&] (int blockIndex) {
+		while (parents[blockIndex] != blockIndex) {
+			parents[blockIndex] = parents[parents[blockIndex]];
+			blockIndex = parents[blockIndex];
+		}
+		return blockIndex;
+	};
+
+	std::vector<std::pair<int, Direction>> blockEdges;
+	for (int blockIndex = 0; blockIndex < blockCount; blockIndex++) {
+		int tileIndex = blockIndex % tilesPerLayer;
+		if (tileIndex % tileColCount + 1 < tileColCount) {
+			blockEdges.push_back ({ blockIndex, Direction::Right });
+		}
+		if (tileIndex / tileColCount + 1 < tileRowCount) {
+			blockEdges.push_back ({ blockIndex, Direction::Bottom });
+		}
+		if (blockIndex / tilesPerLayer + 1 < layerCount) {
+			blockEdges.push_back ({ blockIndex, Direction::Up });
+		}
+	}
+
+	Xoshiro256Engine randomEngine (DeriveSeed (seed, 0));
+	for (size_t i = blockEdges.size (); i > 1; i--) {
+		size_t j = randomEngine.NextBelow ((std::uint32_t) i);
+		std::swap (blockEdges[i - 1], blockEdges[j]);
+	}
+
+	for (const std::pair<int, Direction>& blockEdge : blockEdges) {
+		int blockIndex = blockEdge.first;
+		Direction dir = blockEdge.second;
+		int otherBlockIndex = blockIndex + tilesPerLayer;
+		if (dir == Direction::Right) {
+			otherBlockIndex = blockIndex + 1;
+		} else if (dir == Direction::Bottom) {
+			otherBlockIndex = blockIndex + tileColCount;
+		}
+		int set1 = findSet (blockIndex);
+		int set2 = findSet (otherBlockIndex);
+		if (set1 == set2) {
+			continue;
+		}
+		parents[set2] = set1;
+
+		int layer = blockIndex / tilesPerLayer;
+		int tileIndex = blockIndex % tilesPerLayer;
+		int begRow = (tileIndex / tileColCount) * tileSize;
+		int begCol = (tileIndex % tileColCount) * tileSize;
+		int tileRows = std::min (tileSize, rowCount - begRow);
+		int tileCols = std::min (tileSize, colCount - begCol);
+		Maze& layerMaze = maze.GetLayer (layer);
+		if (dir == Direction::Right) {
+			int row = begRow + (int) randomEngine.NextBelow ((std::uint32_t) tileRows);
+			layerMaze.RemoveWall (layerMaze.ComputeWallId (row, begCol + tileSize - 1, Direction::Right));
+		} else if (dir == Direction::Bottom) {
+			int col = begCol + (int) randomEngine.NextBelow ((std::uint32_t) tileCols);
+			layerMaze.RemoveWall (layerMaze.ComputeWallId (begRow + tileSize - 1, col, Direction::Bottom));
+		} else {
+			int row = begRow + (int) randomEngine.NextBelow ((std::uint32_t) tileRows);
+			int col = begCol + (int) randomEngine.NextBelow ((std::uint32_t) tileCols);
+			maze.AddConnector (layer, row, col);
+		}
+	}
+}
+
+}
@@ -0,0 +1,92 @@
+#ifndef LAYEREDMAZE_HPP
+#define LAYEREDMAZE_HPP
+
+#include "MazeGenerator.hpp"
+
+namespace MG
+{
+
+class MazeConnector
+{
+public:
+	MazeConnector ();
+	MazeConnector (int lowerLayer, double x, double y);
+
+	int		lowerLayer;
+	double	x;
+	double	y;
+};
+
+class LayeredMazeGeometry
+{
+public:
+	LayeredMazeGeometry ();
+
+	std::vector<std::vector<WallGeometry>>	layerWalls;
+	std::vector<MazeConnector>				connectors;
+};
+
+class LayeredMaze
+{
+public:
+	LayeredMaze ();
+	LayeredMaze (int layerCount, int rowCount, int colCount);
+
+	void					Reset (int layerCount, int rowCount, int colCount);
+
+	int						GetLayerCount () const;
+	int						GetRowCount () const;
+	int						GetColCount () const;
+	const Maze&				GetLayer (int layer) const;
+	Maze&					GetLayer (int layer);
+
+	bool					HasPassage (int layer, int row, int col, Direction dir) const;
+	bool					HasConnector (int lowerLayer, int row, int col) const;
+	void					AddConnector (int lowerLayer, int row, int col);
+	size_t					GetConnectorCount () const;
+
+	LayeredMazeGeometry		GetGeometry (double cellSize, int threadCount) const;
+
+private:
+	const std::uint64_t*	GetConnectorRow (int lowerLayer, int row) const;
+
+	int							layers;
+	int							rows;
+	int							cols;
+	int							connectorWordsPerRow;
+	std::vector<Maze>			layerMazes;
+	std::vector<std::uint64_t>	connectorBits;
+};
+
+class LayeredMazeGenerator
+{
+public:
+	static const int DefaultTileSize = 256;
+
+	LayeredMazeGenerator (int layerCount, int rowCount, int colCount, std::uint64_t seed, int threadCount, MazeAlgorithmType algorithmType = MazeAlgorithmType::Prim);
+
+	void				SetTileSize (int newTileSize);
+	int					GetTileSize () const;
+
+	bool				Generate ();
+	const LayeredMaze&	GetMaze () const;
+
+private:
+	void				GenerateTile (int blockIndex, Maze& tileMaze, MazeAlgorithm& tileAlgorithm);
+	void				ConnectBlocks ();
+
+	LayeredMaze			maze;
+	int					layerCount;
+	int					rowCount;
+	int					colCount;
+	std::uint64_t		seed;
+	int					threadCount;
+	MazeAlgorithmType	algorithmType;
+	int					tileSize;
+	int					tileRowCount;
+	int					tileColCount;
+};
+
+}
+
+#endif
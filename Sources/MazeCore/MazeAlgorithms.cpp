@@ -0,0 +1,776 @@
+#include "MazeAlgorithms.hpp"
+
+#include <utility>
+
+namespace MG
+{
+
+static const Direction AllDirections[] = { Direction::Left, Direction::Right, Direction::Top, Direction::Bottom };
+
+static bool NextRandomBool (RandomEngine& randomEngine)
+{
+	return (randomEngine.Next () >> 63) != 0;
+}
+
+static void RemoveWallBetween (Maze& maze, CellId cellId, Direction dir)
+{
+	int cols = maze.GetColCount ();
+	maze.RemoveWall (maze.ComputeWallId (cellId / cols, cellId % cols, dir));
+}
+
+static void ShuffleWalls (ArenaVector<WallId>& walls, RandomEngine& randomEngine)
+{
+	for (size_t i = walls.size (); i > 1; i--) {
+		size_t j = randomEngine.NextBelow ((std::uint32_t) i);
+		std::swap (walls[i - 1], walls[j]);
+	}
+}
+
+template <typename AlgorithmType, typename... ArgumentTypes>
+static MazeAlgorithmPtr CreateArenaAlgorithm (MemoryArena& arena, ArgumentTypes... arguments)
+{
+	void* memory = arena.Allocate (sizeof (AlgorithmType), alignof (AlgorithmType));
+	return MazeAlgorithmPtr (new (memory) AlgorithmType (arguments...), MazeAlgorithmDeleter (true));
+}
+
+MazeAlgorithmDeleter::MazeAlgorithmDeleter () :
+	arenaAllocated (false)
+{
+
+}
+
+MazeAlgorithmDeleter::MazeAlgorithmDeleter (bool arenaAllocated) :
+	arenaAllocated (arenaAllocated)
+{
+
+}
+
+void MazeAlgorithmDeleter::operator() (MazeAlgorithm* algorithm) const
+{
+	if (arenaAllocated) {
+		algorithm->~MazeAlgorithm ();
+	} else {
+		delete algorithm;
+	}
+}
+
+MazeAlgorithm::MazeAlgorithm () :
+	cancellationToken (nullptr)
+{
+
+}
+
+MazeAlgorithm::~MazeAlgorithm ()
+{
+
+}
+
+void MazeAlgorithm::SetCancellationToken (const CancellationToken* newCancellationToken)
+{
+	cancellationToken = newCancellationToken;
+}
+
+bool MazeAlgorithm::IsCancelled () const
+{
+	return cancellationToken != nullptr && cancellationToken->IsCancelled ();
+}
+
+bool MazeAlgorithm::CheckCancelled (size_t& stepCount) const
+{
+	stepCount += 1;
+	return stepCount % CancellationCheckInterval == 0 && IsCancelled ();
+}
+
+bool MazeAlgorithm::GenerateMasked (Maze&, const CellMask&, RandomEngine&)
+{
+	return false;
+}
+
+PrimAlgorithm::PrimAlgorithm (MemoryArena* arena) :
+	maskIndex (arena),
+	visited (ArenaAllocator<bool> (arena)),
+	frontier (ArenaAllocator<WallId> (arena))
+{
+
+}
+
+void PrimAlgorithm::Generate (Maze& maze, RandomEngine& randomEngine)
+{
+	visited.assign (maze.GetCellCount (), false);
+	frontier.clear ();
+
+	VisitCell (maze, maze.GetCellId (0, 0));
+
+	size_t stepCount = 0;
+	while (!frontier.empty () && !CheckCancelled (stepCount)) {
+		WallId wallId = TakeRandomWall (randomEngine);
+		Wall wall = maze.GetWall (wallId);
+		CellId cellId1 = wall.GetCellId1 ();
+		CellId cellId2 = wall.GetCellId2 ();
+		bool cellVisited1 = visited[cellId1];
+		bool cellVisited2 = visited[cellId2];
+		if (cellVisited1 != cellVisited2) {
+			CellId newCellId = (cellVisited1 ? cellId2 : cellId1);
+			maze.RemoveWall (wallId);
+			VisitCell (maze, newCellId);
+		}
+	}
+}
+
+bool PrimAlgorithm::GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine)
+{
+	maskIndex.Build (cellMask);
+	visited.assign (maskIndex.GetActiveCellCount (), false);
+	frontier.clear ();
+
+	VisitMaskedCell (maze, maskIndex.GetCellId (0));
+
+	size_t stepCount = 0;
+	while (!frontier.empty () && !CheckCancelled (stepCount)) {
+		WallId wallId = TakeRandomWall (randomEngine);
+		Wall wall = maze.GetWall (wallId);
+		CellId cellId1 = wall.GetCellId1 ();
+		CellId cellId2 = wall.GetCellId2 ();
+		bool cellVisited1 = visited[maskIndex.GetCellIndex (cellId1)];
+		bool cellVisited2 = visited[maskIndex.GetCellIndex (cellId2)];
+		if (cellVisited1 != cellVisited2) {
+			CellId newCellId = (cellVisited1 ? cellId2 : cellId1);
+			maze.RemoveWall (wallId);
+			VisitMaskedCell (maze, newCellId);
+		}
+	}
+	return !IsCancelled ();
+}
+
+void PrimAlgorithm::VisitCell (const Maze& maze, CellId cellId)
+{
+	int cols = maze.GetColCount ();
+	int row = cellId / cols;
+	int col = cellId % cols;
+	for (Direction dir : AllDirections) {
+		CellId otherCellId = maze.GetNeighbourCellId (cellId, dir);
+		if (otherCellId == InvalidCellId || visited[otherCellId]) {
+			continue;
+		}
+		WallId wallId = maze.GetWallId (row, col, dir);
+		if (wallId != InvalidWallId) {
+			frontier.push_back (wallId);
+		}
+	}
+	visited[cellId] = true;
+}
+
+void PrimAlgorithm::VisitMaskedCell (const Maze& maze, CellId cellId)
+{
+	int cols = maze.GetColCount ();
+	int row = cellId / cols;
+	int col = cellId % cols;
+	for (Direction dir : AllDirections) {
+		int otherCellIndex = maskIndex.GetCellIndex (maze.GetNeighbourCellId (cellId, dir));
+		if (otherCellIndex < 0 || visited[otherCellIndex]) {
+			continue;
+		}
+		WallId wallId = maze.GetWallId (row, col, dir);
+		if (wallId != InvalidWallId) {
+			frontier.push_back (wallId);
+		}
+	}
+	visited[maskIndex.GetCellIndex (cellId)] = true;
+}
+
+WallId PrimAlgorithm::TakeRandomWall (RandomEngine& randomEngine)
+{
+	if (frontier.empty ()) {
+		return InvalidWallId;
+	}
+	size_t index = randomEngine.NextBelow ((std::uint32_t) frontier.size ());
+	WallId wallId = frontier[index];
+	frontier[index] = frontier.back ();
+	frontier.pop_back ();
+	return wallId;
+}
+
+WeightedPrimAlgorithm::WeightedPrimAlgorithm (const MazeBiasField& biasField, MemoryArena* arena) :
+	biasField (biasField),
+	useBiasField (false),
+	visited (ArenaAllocator<bool> (arena)),
+	frontier (arena)
+{
+
+}
+
+void WeightedPrimAlgorithm::Generate (Maze& maze, RandomEngine& randomEngine)
+{
+	useBiasField = (biasField.GetRowCount () == maze.GetRowCount () && biasField.GetColCount () == maze.GetColCount ());
+	visited.assign (maze.GetCellCount (), false);
+	frontier.Reset (maze.GetWallSlotCount ());
+
+	VisitCell (maze, maze.GetCellId (0, 0));
+
+	size_t stepCount = 0;
+	while (frontier.GetTotalWeight () > 0 && !CheckCancelled (stepCount)) {
+		WallId wallId = frontier.Sample (randomEngine);
+		Wall wall = maze.GetWall (wallId);
+		CellId newCellId = (visited[wall.GetCellId1 ()] ? wall.GetCellId2 () : wall.GetCellId1 ());
+		maze.RemoveWall (wallId);
+		VisitCell (maze, newCellId);
+	}
+}
+
+void WeightedPrimAlgorithm::VisitCell (const Maze& maze, CellId cellId)
+{
+	int cols = maze.GetColCount ();
+	int row = cellId / cols;
+	int col = cellId % cols;
+	for (Direction dir : AllDirections) {
+		CellId otherCellId = maze.GetNeighbourCellId (cellId, dir);
+		if (otherCellId == InvalidCellId) {
+			continue;
+		}
+		// Walls between two visited cells leave the frontier right away, so every sample opens a new cell.
+		WallId wallId = maze.ComputeWallId (row, col, dir);
+		if (visited[otherCellId]) {
+			frontier.SetWeight (wallId, 0);
+		} else if (!useBiasField) {
+			frontier.SetWeight (wallId, MazeBiasField::NeutralWeight);
+		} else if (dir == Direction::Left || dir == Direction::Right) {
+			frontier.SetWeight (wallId, biasField.GetHorizontalWeight (otherCellId));
+		} else {
+			frontier.SetWeight (wallId, biasField.GetVerticalWeight (otherCellId));
+		}
+	}
+	visited[cellId] = true;
+}
+
+KruskalAlgorithm::KruskalAlgorithm (MemoryArena* arena) :
+	maskIndex (arena),
+	parents (ArenaAllocator<CellId> (arena)),
+	sizes (ArenaAllocator<int> (arena)),
+	walls (ArenaAllocator<WallId> (arena))
+{
+
+}
+
+void KruskalAlgorithm::Generate (Maze& maze, RandomEngine& randomEngine)
+{
+	int rows = maze.GetRowCount ();
+	int cols = maze.GetColCount ();
+	int cellCount = maze.GetCellCount ();
+
+	parents.resize (cellCount);
+	sizes.assign (cellCount, 1);
+	for (CellId cellId = 0; cellId < cellCount; cellId++) {
+		parents[cellId] = cellId;
+	}
+
+	walls.clear ();
+	walls.reserve ((size_t) 2 * cellCount);
+	for (int row = 0; row < rows; row++) {
+		for (int col = 0; col < cols; col++) {
+			if (col > 0) {
+				walls.push_back (maze.ComputeWallId (row, col, Direction::Left));
+			}
+			if (row > 0) {
+				walls.push_back (maze.ComputeWallId (row, col, Direction::Top));
+			}
+		}
+	}
+
+	ShuffleWalls (walls, randomEngine);
+
+	int remainingUnions = cellCount - 1;
+	size_t stepCount = 0;
+	for (size_t i = 0; i < walls.size () && remainingUnions > 0 && !CheckCancelled (stepCount); i++) {
+		Wall wall = maze.GetWall (walls[i]);
+		CellId root1 = FindSet (wall.GetCellId1 ());
+		CellId root2 = FindSet (wall.GetCellId2 ());
+		if (root1 == root2) {
+			continue;
+		}
+		if (sizes[root1] < sizes[root2]) {
+			std::swap (root1, root2);
+		}
+		parents[root2] = root1;
+		sizes[root1] += sizes[root2];
+		maze.RemoveWall (walls[i]);
+		remainingUnions--;
+	}
+}
+
+bool KruskalAlgorithm::GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine)
+{
+	int cols = maze.GetColCount ();
+	maskIndex.Build (cellMask);
+	int cellCount = maskIndex.GetActiveCellCount ();
+
+	parents.resize (cellCount);
+	sizes.assign (cellCount, 1);
+	walls.clear ();
+	walls.reserve ((size_t) 2 * cellCount);
+	for (int cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+		parents[cellIndex] = cellIndex;
+		CellId cellId = maskIndex.GetCellId (cellIndex);
+		int row = cellId / cols;
+		int col = cellId % cols;
+		if (cellMask.IsCellActive (row, col - 1)) {
+			walls.push_back (maze.ComputeWallId (row, col, Direction::Left));
+		}
+		if (cellMask.IsCellActive (row - 1, col)) {
+			walls.push_back (maze.ComputeWallId (row, col, Direction::Top));
+		}
+	}
+
+	ShuffleWalls (walls, randomEngine);
+
+	int remainingUnions = cellCount - 1;
+	size_t stepCount = 0;
+	for (size_t i = 0; i < walls.size () && remainingUnions > 0 && !CheckCancelled (stepCount); i++) {
+		Wall wall = maze.GetWall (walls[i]);
+		int root1 = FindSet (maskIndex.GetCellIndex (wall.GetCellId1 ()));
+		int root2 = FindSet (maskIndex.GetCellIndex (wall.GetCellId2 ()));
+		if (root1 == root2) {
+			continue;
+		}
+		if (sizes[root1] < sizes[root2]) {
+			std::swap (root1, root2);
+		}
+		parents[root2] = root1;
+		sizes[root1] += sizes[root2];
+		maze.RemoveWall (walls[i]);
+		remainingUnions--;
+	}
+	return !IsCancelled ();
+}
+
+CellId KruskalAlgorithm::FindSet (CellId cellId)
+{
+	while (parents[cellId] != cellId) {
+		parents[cellId] = parents[parents[cellId]];
+		cellId = parents[cellId];
+	}
+	return cellId;
+}
+
+RecursiveBacktrackerAlgorithm::RecursiveBacktrackerAlgorithm (MemoryArena* arena) :
+	maskIndex (arena),
+	visited (ArenaAllocator<bool> (arena)),
+	stack (ArenaAllocator<CellId> (arena))
+{
+
+}
+
+void RecursiveBacktrackerAlgorithm::Generate (Maze& maze, RandomEngine& randomEngine)
+{
+	visited.assign (maze.GetCellCount (), false);
+	stack.clear ();
+
+	CellId firstCellId = maze.GetCellId (0, 0);
+	visited[firstCellId] = true;
+	stack.push_back (firstCellId);
+
+	size_t stepCount = 0;
+	while (!stack.empty () && !CheckCancelled (stepCount)) {
+		CellId cellId = stack.back ();
+		Direction candidates[4];
+		std::uint32_t candidateCount = 0;
+		for (Direction dir : AllDirections) {
+			CellId otherCellId = maze.GetNeighbourCellId (cellId, dir);
+			if (otherCellId != InvalidCellId && !visited[otherCellId]) {
+				candidates[candidateCount++] = dir;
+			}
+		}
+		if (candidateCount == 0) {
+			stack.pop_back ();
+			continue;
+		}
+		Direction dir = candidates[randomEngine.NextBelow (candidateCount)];
+		CellId nextCellId = maze.GetNeighbourCellId (cellId, dir);
+		RemoveWallBetween (maze, cellId, dir);
+		visited[nextCellId] = true;
+		stack.push_back (nextCellId);
+	}
+}
+
+bool RecursiveBacktrackerAlgorithm::GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine)
+{
+	maskIndex.Build (cellMask);
+	visited.assign (maskIndex.GetActiveCellCount (), false);
+	stack.clear ();
+
+	CellId firstCellId = maskIndex.GetCellId (0);
+	visited[0] = true;
+	stack.push_back (firstCellId);
+
+	size_t stepCount = 0;
+	while (!stack.empty () && !CheckCancelled (stepCount)) {
+		CellId cellId = stack.back ();
+		Direction candidates[4];
+		int candidateIndices[4];
+		std::uint32_t candidateCount = 0;
+		for (Direction dir : AllDirections) {
+			int otherCellIndex = maskIndex.GetCellIndex (maze.GetNeighbourCellId (cellId, dir));
+			if (otherCellIndex >= 0 && !visited[otherCellIndex]) {
+				candidateIndices[candidateCount] = otherCellIndex;
+				candidates[candidateCount++] = dir;
+			}
+		}
+		if (candidateCount == 0) {
+			stack.pop_back ();
+			continue;
+		}
+		std::uint32_t candidate = randomEngine.NextBelow (candidateCount);
+		RemoveWallBetween (maze, cellId, candidates[candidate]);
+		visited[candidateIndices[candidate]] = true;
+		stack.push_back (maskIndex.GetCellId (candidateIndices[candidate]));
+	}
+	return !IsCancelled ();
+}
+
+WilsonAlgorithm::WilsonAlgorithm (MemoryArena* arena) :
+	maskIndex (arena),
+	inMaze (ArenaAllocator<bool> (arena)),
+	walkDirections (ArenaAllocator<unsigned char> (arena))
+{
+
+}
+
+void WilsonAlgorithm::Generate (Maze& maze, RandomEngine& randomEngine)
+{
+	int cellCount = maze.GetCellCount ();
+	inMaze.assign (cellCount, false);
+	walkDirections.assign (cellCount, 0);
+
+	inMaze[randomEngine.NextBelow ((std::uint32_t) cellCount)] = true;
+
+	size_t stepCount = 0;
+	for (CellId startCellId = 0; startCellId < cellCount; startCellId++) {
+		if (inMaze[startCellId]) {
+			continue;
+		}
+
+		CellId cellId = startCellId;
+		while (!inMaze[cellId]) {
+			if (CheckCancelled (stepCount)) {
+				return;
+			}
+			unsigned char candidates[4];
+			std::uint32_t candidateCount = 0;
+			for (unsigned char dirIndex = 0; dirIndex < 4; dirIndex++) {
+				if (maze.GetNeighbourCellId (cellId, AllDirections[dirIndex]) != InvalidCellId) {
+					candidates[candidateCount++] = dirIndex;
+				}
+			}
+			unsigned char dirIndex = candidates[randomEngine.NextBelow (candidateCount)];
+			walkDirections[cellId] = dirIndex;
+			cellId = maze.GetNeighbourCellId (cellId, AllDirections[dirIndex]);
+		}
+
+		cellId = startCellId;
+		while (!inMaze[cellId]) {
+			Direction dir = AllDirections[walkDirections[cellId]];
+			inMaze[cellId] = true;
+			RemoveWallBetween (maze, cellId, dir);
+			cellId = maze.GetNeighbourCellId (cellId, dir);
+		}
+	}
+}
+
+bool WilsonAlgorithm::GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine)
+{
+	maskIndex.Build (cellMask);
+	int cellCount = maskIndex.GetActiveCellCount ();
+	inMaze.assign (cellCount, false);
+	walkDirections.assign (cellCount, 0);
+
+	inMaze[randomEngine.NextBelow ((std::uint32_t) cellCount)] = true;
+
+	size_t stepCount = 0;
+	for (int startCellIndex = 0; startCellIndex < cellCount; startCellIndex++) {
+		if (inMaze[startCellIndex]) {
+			continue;
+		}
+
+		CellId cellId = maskIndex.GetCellId (startCellIndex);
+		int cellIndex = startCellIndex;
+		while (!inMaze[cellIndex]) {
+			if (CheckCancelled (stepCount)) {
+				return false;
+			}
+			unsigned char candidates[4];
+			int candidateIndices[4];
+			std::uint32_t candidateCount = 0;
+			for (unsigned char dirIndex = 0; dirIndex < 4; dirIndex++) {
+				int otherCellIndex = maskIndex.GetCellIndex (maze.GetNeighbourCellId (cellId, AllDirections[dirIndex]));
+				if (otherCellIndex >= 0) {
+					candidateIndices[candidateCount] = otherCellIndex;
+					candidates[candidateCount++] = dirIndex;
+				}
+			}
+			std::uint32_t candidate = randomEngine.NextBelow (candidateCount);
+			walkDirections[cellIndex] = candidates[candidate];
+			cellId = maze.GetNeighbourCellId (cellId, AllDirections[candidates[candidate]]);
+			cellIndex = candidateIndices[candidate];
+		}
+
+		cellId = maskIndex.GetCellId (startCellIndex);
+		cellIndex = startCellIndex;
+		while (!inMaze[cellIndex]) {
+			Direction dir = AllDirections[walkDirections[cellIndex]];
+			inMaze[cellIndex] = true;
+			RemoveWallBetween (maze, cellId, dir);
+			cellId = maze.GetNeighbourCellId (cellId, dir);
+			cellIndex = maskIndex.GetCellIndex (cellId);
+		}
+	}
+	return !IsCancelled ();
+}
+
+EllerRowGenerator::EllerRowGenerator (MemoryArena* arena) :
+	cols (0),
+	cellSets (ArenaAllocator<int> (arena)),
+	parents (ArenaAllocator<int> (arena)),
+	remaining (ArenaAllocator<int> (arena)),
+	hasDownPassage (ArenaAllocator<bool> (arena)),
+	freeSets (ArenaAllocator<int> (arena))
+{
+
+}
+
+void EllerRowGenerator::Start (int colCount)
+{
+	cols = colCount;
+	cellSets.resize (cols);
+	parents.resize (cols);
+	freeSets.clear ();
+	for (int col = 0; col < cols; col++) {
+		cellSets[col] = col;
+	}
+}
+
+void EllerRowGenerator::GenerateRow (bool lastRow, RandomEngine& randomEngine, ArenaVector<unsigned char>& rightPassages, ArenaVector<unsigned char>& bottomPassages)
+{
+	rightPassages.assign (cols, 0);
+	bottomPassages.assign (cols, 0);
+	for (int setId = 0; setId < cols; setId++) {
+		parents[setId] = setId;
+	}
+
+	for (int col = 0; col + 1 < cols; col++) {
+		int set1 = FindSet (cellSets[col]);
+		int set2 = FindSet (cellSets[col + 1]);
+		if (set1 == set2 || (!lastRow && !NextRandomBool (randomEngine))) {
+			continue;
+		}
+		parents[set2] = set1;
+		rightPassages[col] = 1;
+	}
+
+	if (lastRow) {
+		return;
+	}
+
+	for (int col = 0; col < cols; col++) {
+		cellSets[col] = FindSet (cellSets[col]);
+	}
+	remaining.assign (cols, 0);
+	hasDownPassage.assign (cols, false);
+	for (int col = 0; col < cols; col++) {
+		remaining[cellSets[col]]++;
+	}
+
+	for (int col = 0; col < cols; col++) {
+		int setId = cellSets[col];
+		remaining[setId]--;
+		bool goDown = NextRandomBool (randomEngine) || (remaining[setId] == 0 && !hasDownPassage[setId]);
+		if (goDown) {
+			hasDownPassage[setId] = true;
+			bottomPassages[col] = 1;
+		} else {
+			cellSets[col] = -1;
+		}
+	}
+
+	freeSets.clear ();
+	for (int setId = cols - 1; setId >= 0; setId--) {
+		if (!hasDownPassage[setId]) {
+			freeSets.push_back (setId);
+		}
+	}
+	for (int col = 0; col < cols; col++) {
+		if (cellSets[col] == -1) {
+			cellSets[col] = freeSets.back ();
+			freeSets.pop_back ();
+		}
+	}
+}
+
+int EllerRowGenerator::FindSet (int setId)
+{
+	while (parents[setId] != setId) {
+		parents[setId] = parents[parents[setId]];
+		setId = parents[setId];
+	}
+	return setId;
+}
+
+EllerAlgorithm::EllerAlgorithm (MemoryArena* arena) :
+	rowGenerator (arena),
+	rightPassages (ArenaAllocator<unsigned char> (arena)),
+	bottomPassages (ArenaAllocator<unsigned char> (arena))
+{
+
+}
+
+void EllerAlgorithm::Generate (Maze& maze, RandomEngine& randomEngine)
+{
+	int rows = maze.GetRowCount ();
+	int cols = maze.GetColCount ();
+
+	rowGenerator.Start (cols);
+	for (int row = 0; row < rows && !IsCancelled (); row++) {
+		rowGenerator.GenerateRow (row == rows - 1, randomEngine, rightPassages, bottomPassages);
+		for (int col = 0; col < cols; col++) {
+			if (rightPassages[col] != 0) {
+				maze.RemoveWall (maze.ComputeWallId (row, col, Direction::Right));
+			}
+			if (bottomPassages[col] != 0) {
+				maze.RemoveWall (maze.ComputeWallId (row, col, Direction::Bottom));
+			}
+		}
+	}
+}
+
+void BinaryTreeAlgorithm::Generate (Maze& maze, RandomEngine& randomEngine)
+{
+	int rows = maze.GetRowCount ();
+	int cols = maze.GetColCount ();
+	for (int row = 0; row < rows && !IsCancelled (); row++) {
+		for (int col = 0; col < cols; col++) {
+			if (row == 0 && col == 0) {
+				continue;
+			}
+			Direction dir = Direction::Invalid;
+			if (row == 0) {
+				dir = Direction::Left;
+			} else if (col == 0) {
+				dir = Direction::Top;
+			} else {
+				dir = NextRandomBool (randomEngine) ? Direction::Left : Direction::Top;
+			}
+			maze.RemoveWall (maze.ComputeWallId (row, col, dir));
+		}
+	}
+}
+
+void SidewinderAlgorithm::Generate (Maze& maze, RandomEngine& randomEngine)
+{
+	int rows = maze.GetRowCount ();
+	int cols = maze.GetColCount ();
+	for (int row = 0; row < rows && !IsCancelled (); row++) {
+		int runStart = 0;
+		for (int col = 0; col < cols; col++) {
+			bool atEastEdge = (col == cols - 1);
+			bool closeRun = atEastEdge || (row > 0 && NextRandomBool (randomEngine));
+			if (!closeRun) {
+				maze.RemoveWall (maze.ComputeWallId (row, col, Direction::Right));
+				continue;
+			}
+			if (row > 0) {
+				int runLength = col - runStart + 1;
+				int carveCol = runStart + (int) randomEngine.NextBelow ((std::uint32_t) runLength);
+				maze.RemoveWall (maze.ComputeWallId (row, carveCol, Direction::Top));
+			}
+			runStart = col + 1;
+		}
+	}
+}
+
+std::unique_ptr<MazeAlgorithm> CreateMazeAlgorithm (MazeAlgorithmType algorithmType)
+{
+	switch (algorithmType) {
+	case MazeAlgorithmType::Prim:
+		return std::unique_ptr<MazeAlgorithm> (new PrimAlgorithm ());
+	case MazeAlgorithmType::Kruskal:
+		return std::unique_ptr<MazeAlgorithm> (new KruskalAlgorithm ());
+	case MazeAlgorithmType::RecursiveBacktracker:
+		return std::unique_ptr<MazeAlgorithm> (new RecursiveBacktrackerAlgorithm ());
+	case MazeAlgorithmType::Wilson:
+		return std::unique_ptr<MazeAlgorithm> (new WilsonAlgorithm ());
+	case MazeAlgorithmType::Eller:
+		return std::unique_ptr<MazeAlgorithm> (new EllerAlgorithm ());
+	case MazeAlgorithmType::BinaryTree:
+		return std::unique_ptr<MazeAlgorithm> (new BinaryTreeAlgorithm ());
+	case MazeAlgorithmType::Sidewinder:
+		return std::unique_ptr<MazeAlgorithm> (new SidewinderAlgorithm ());
+	}
+	return nullptr;
+}
+
+MazeAlgorithmPtr CreateMazeAlgorithm (MazeAlgorithmType algorithmType, MemoryArena& arena)
+{
+	switch (algorithmType) {
+	case MazeAlgorithmType::Prim:
+		return CreateArenaAlgorithm<PrimAlgorithm> (arena, &arena);
+	case MazeAlgorithmType::Kruskal:
+		return CreateArenaAlgorithm<KruskalAlgorithm> (arena, &arena);
+	case MazeAlgorithmType::RecursiveBacktracker:
+		return CreateArenaAlgorithm<RecursiveBacktrackerAlgorithm> (arena, &arena);
+	case MazeAlgorithmType::Wilson:
+		return CreateArenaAlgorithm<WilsonAlgorithm> (arena, &arena);
+	case MazeAlgorithmType::Eller:
+		return CreateArenaAlgorithm<EllerAlgorithm> (arena, &arena);
+	case MazeAlgorithmType::BinaryTree:
+		return CreateArenaAlgorithm<BinaryTreeAlgorithm> (arena);
+	case MazeAlgorithmType::Sidewinder:
+		return CreateArenaAlgorithm<SidewinderAlgorithm> (arena);
+	}
+	return nullptr;
+}
+
+const char* GetMazeAlgorithmName (MazeAlgorithmType algorithmType)
+{
+	switch (algorithmType) {
+	case MazeAlgorithmType::Prim:
+		return "prim";
+	case MazeAlgorithmType::Kruskal:
+		return "kruskal";
+	case MazeAlgorithmType::RecursiveBacktracker:
+		return "backtracker";
+	case MazeAlgorithmType::Wilson:
+		return "wilson";
+	case MazeAlgorithmType::Eller:
+		return "eller";
+	case MazeAlgorithmType::BinaryTree:
+		return "binarytree";
+	case MazeAlgorithmType::Sidewinder:
+		return "sidewinder";
+	}
+	return "";
+}
+
+bool FindMazeAlgorithmType (const std::string& name, MazeAlgorithmType& algorithmType)
+{
+	for (MazeAlgorithmType candidate : GetAllMazeAlgorithmTypes ()) {
+		if (name == GetMazeAlgorithmName (candidate)) {
+			algorithmType = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+const std::vector<MazeAlgorithmType>& GetAllMazeAlgorithmTypes ()
+{
+	static const std::vector<MazeAlgorithmType> algorithmTypes = {
+		MazeAlgorithmType::Prim,
+		MazeAlgorithmType::Kruskal,
+		MazeAlgorithmType::RecursiveBacktracker,
+		MazeAlgorithmType::Wilson,
+		MazeAlgorithmType::Eller,
+		MazeAlgorithmType::BinaryTree,
+		MazeAlgorithmType::Sidewinder
+	};
+	return algorithmTypes;
+}
+
+}
@@ -0,0 +1,168 @@
+#ifndef MAZEALGORITHMS_HPP
+#define MAZEALGORITHMS_HPP
+
+#include "MazeGenerator.hpp"
+#include "CellMask.hpp"
+#include "MazeBias.hpp"
+#include "WeightedSampler.hpp"
+
+#include <string>
+
+namespace MG
+{
+
+class MazeAlgorithm
+{
+public:
+	static const size_t CancellationCheckInterval = 4096;
+
+	MazeAlgorithm ();
+	virtual ~MazeAlgorithm ();
+
+	void			SetCancellationToken (const CancellationToken* newCancellationToken);
+	bool			IsCancelled () const;
+
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) = 0;
+	virtual bool	GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine);
+
+protected:
+	bool			CheckCancelled (size_t& stepCount) const;
+
+private:
+	const CancellationToken*	cancellationToken;
+};
+
+class PrimAlgorithm : public MazeAlgorithm
+{
+public:
+	explicit PrimAlgorithm (MemoryArena* arena = nullptr);
+
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) override;
+	virtual bool	GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine) override;
+
+private:
+	void			VisitCell (const Maze& maze, CellId cellId);
+	void			VisitMaskedCell (const Maze& maze, CellId cellId);
+	WallId			TakeRandomWall (RandomEngine& randomEngine);
+
+	CellMaskIndex			maskIndex;
+	ArenaVector<bool>		visited;
+	ArenaVector<WallId>		frontier;
+};
+
+class WeightedPrimAlgorithm : public MazeAlgorithm
+{
+public:
+	explicit WeightedPrimAlgorithm (const MazeBiasField& biasField, MemoryArena* arena = nullptr);
+
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) override;
+
+private:
+	void			VisitCell (const Maze& maze, CellId cellId);
+
+	const MazeBiasField&	biasField;
+	bool					useBiasField;
+	ArenaVector<bool>		visited;
+	WeightedSampler			frontier;
+};
+
+class KruskalAlgorithm : public MazeAlgorithm
+{
+public:
+	explicit KruskalAlgorithm (MemoryArena* arena = nullptr);
+
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) override;
+	virtual bool	GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine) override;
+
+private:
+	CellId			FindSet (CellId cellId);
+
+	CellMaskIndex			maskIndex;
+	ArenaVector<CellId>		parents;
+	ArenaVector<int>		sizes;
+	ArenaVector<WallId>		walls;
+};
+
+class RecursiveBacktrackerAlgorithm : public MazeAlgorithm
+{
+public:
+	explicit RecursiveBacktrackerAlgorithm (MemoryArena* arena = nullptr);
+
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) override;
+	virtual bool	GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine) override;
+
+private:
+	CellMaskIndex			maskIndex;
+	ArenaVector<bool>		visited;
+	ArenaVector<CellId>		stack;
+};
+
+class WilsonAlgorithm : public MazeAlgorithm
+{
+public:
+	explicit WilsonAlgorithm (MemoryArena* arena = nullptr);
+
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) override;
+	virtual bool	GenerateMasked (Maze& maze, const CellMask& cellMask, RandomEngine& randomEngine) override;
+
+private:
+	CellMaskIndex				maskIndex;
+	ArenaVector<bool>			inMaze;
+	ArenaVector<unsigned char>	walkDirections;
+};
+
+class EllerRowGenerator
+{
+public:
+	explicit EllerRowGenerator (MemoryArena* arena = nullptr);
+
+	void	Start (int colCount);
+	void	GenerateRow (bool lastRow, RandomEngine& randomEngine, ArenaVector<unsigned char>& rightPassages, ArenaVector<unsigned char>& bottomPassages);
+
+private:
+	int		FindSet (int setId);
+
+	int					cols;
+	ArenaVector<int>	cellSets;
+	ArenaVector<int>	parents;
+	ArenaVector<int>	remaining;
+	ArenaVector<bool>	hasDownPassage;
+	ArenaVector<int>	freeSets;
+};
+
+class EllerAlgorithm : public MazeAlgorithm
+{
+public:
+	explicit EllerAlgorithm (MemoryArena* arena = nullptr);
+
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) override;
+
+private:
+	EllerRowGenerator			rowGenerator;
+	ArenaVector<unsigned char>	rightPassages;
+	ArenaVector<unsigned char>	bottomPassages;
+};
+
+class BinaryTreeAlgorithm : public MazeAlgorithm
+{
+public:
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) override;
+};
+
+class SidewinderAlgorithm : public MazeAlgorithm
+{
+public:
+	virtual void	Generate (Maze& maze, RandomEngine& randomEngine) override;
+};
+
+std::unique_ptr<MazeAlgorithm>	CreateMazeAlgorithm (MazeAlgorithmType algorithmType);
+MazeAlgorithmPtr				CreateMazeAlgorithm (MazeAlgorithmType algorithmType, MemoryArena& arena);
+bool							GenerateMaze (Maze& maze, int rowCount, int colCount, MazeAlgorithm& algorithm, RandomEngine& randomEngine);
+bool							GenerateMaze (Maze& maze, const CellMask& cellMask, MazeAlgorithm& algorithm, RandomEngine& randomEngine);
+const char*						GetMazeAlgorithmName (MazeAlgorithmType algorithmType);
+bool							FindMazeAlgorithmType (const std::string& name, MazeAlgorithmType& algorithmType);
+const std::vector<MazeAlgorithmType>&	GetAllMazeAlgorithmTypes ();
+
+}
+
+#endif
@@ -0,0 +1,287 @@
+#include "MazeBatch.hpp"
+#include "MazeAlgorithms.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <thread>
+
+namespace MG
+{
+
+class BatchJobDeque
+{
+public:
+	BatchJobDeque ();
+
+	void	PushBack (size_t jobIndex);
+	bool	PopFront (size_t& jobIndex);
+	bool	PopBack (size_t& jobIndex);
+
+private:
+	std::mutex			mutex;
+	std::deque<size_t>	jobIndices;
+};
+
+BatchJobDeque::BatchJobDeque () :
+	mutex (),
+	jobIndices ()
+{
+
+}
+
+void BatchJobDeque::PushBack (size_t jobIndex)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	jobIndices.push_back (jobIndex);
+}
+
+bool BatchJobDeque::PopFront (size_t& jobIndex)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	if (jobIndices.empty ()) {
+		return false;
+	}
+	jobIndex = jobIndices.front ();
+	jobIndices.pop_front ();
+	return true;
+}
+
+bool BatchJobDeque::PopBack (size_t& jobIndex)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	if (jobIndices.empty ()) {
+		return false;
+	}
+	jobIndex = jobIndices.back ();
+	jobIndices.pop_back ();
+	return true;
+}
+
+class BatchResultQueue
+{
+public:
+	BatchResultQueue (size_t maxResultCount, int workerCount);
+
+	bool	Push (MazeBatchResult& result);
+	bool	Pop (MazeBatchResult& result);
+	void	FinishWorker ();
+	void	Stop ();
+	bool	IsStopped () const;
+
+private:
+	std::mutex					mutex;
+	std::condition_variable		changed;
+	std::deque<MazeBatchResult>	results;
+	size_t						maxResultCount;
+	int							runningWorkerCount;
+	std::atomic<bool>			stopped;
+};
+
+BatchResultQueue::BatchResultQueue (size_t maxResultCount, int workerCount) :
+	mutex (),
+	changed (),
+	results (),
+	maxResultCount (maxResultCount),
+	runningWorkerCount (workerCount),
+	stopped (false)
+{
+
+}
+
+bool BatchResultQueue::Push (MazeBatchResult& result)
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	changed.wait (lock, [&] () {
+		return results.size () < maxResultCount || stopped;
+	});
+	if (stopped) {
+		return false;
+	}
+	results.push_back (std::move (result));
+	changed.notify_all ();
+	return true;
+}
+
+bool BatchResultQueue::Pop (MazeBatchResult& result)
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	changed.wait (lock, [&] () {
+		return !results.empty () || runningWorkerCount == 0;
+	});
+	if (results.empty ()) {
+		return false;
+	}
+	result = std::move (results.front ());
+	results.pop_front ();
+	changed.notify_all ();
+	return true;
+}
+
+void BatchResultQueue::FinishWorker ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	runningWorkerCount -= 1;
+	changed.notify_all ();
+}
+
+void BatchResultQueue::Stop ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	stopped = true;
+	changed.notify_all ();
+}
+
+bool BatchResultQueue::IsStopped () const
+{
+	return stopped;
+}
+
+static bool TakeBatchJob (std::vector<BatchJobDeque>& jobDeques, int workerIndex, size_t& jobIndex, bool& stolen)
+{
+	stolen = false;
+	if (jobDeques[workerIndex].PopFront (jobIndex)) {
+		return true;
+	}
+	int workerCount = (int) jobDeques.size ();
+	for (int offset = 1; offset < workerCount; offset++) {
+		if (jobDeques[(workerIndex + offset) % workerCount].PopBack (jobIndex)) {
+			stolen = true;
+			return true;
+		}
+	}
+	return false;
+}
+
+static bool IsValidBatchJob (const MazeBatchJob& job)
+{
+	if (job.rowCount <= 0 || job.colCount <= 0) {
+		return false;
+	}
+	const std::vector<MazeAlgorithmType>& algorithmTypes = GetAllMazeAlgorithmTypes ();
+	return std::find (algorithmTypes.begin (), algorithmTypes.end (), job.algorithmType) != algorithmTypes.end ();
+}
+
+MazeBatchJob::MazeBatchJob () :
+	MazeBatchJob (0, 0, 0, MazeAlgorithmType::Prim)
+{
+
+}
+
+MazeBatchJob::MazeBatchJob (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType) :
+	rowCount (rowCount),
+	colCount (colCount),
+	seed (seed),
+	algorithmType (algorithmType)
+{
+
+}
+
+MazeBatchResult::MazeBatchResult () :
+	jobIndex (0),
+	succeeded (false),
+	workerIndex (0),
+	generationMs (0.0),
+	maze ()
+{
+
+}
+
+MazeBatchStats::MazeBatchStats () :
+	stopped (false),
+	workerCount (0),
+	completedJobCount (0),
+	stolenJobCount (0),
+	totalMs (0.0)
+{
+
+}
+
+MazeBatchGenerator::MazeBatchGenerator (int threadCount) :
+	threadCount (threadCount),
+	maxQueuedResultCount (0)
+{
+
+}
+
+void MazeBatchGenerator::SetMaxQueuedResultCount (size_t newMaxQueuedResultCount)
+{
+	maxQueuedResultCount = newMaxQueuedResultCount;
+}
+
+MazeBatchStats MazeBatchGenerator::Run (const std::vector<MazeBatchJob>& jobs, const MazeBatchResultCallback& resultCallback)
+{
+	auto startTime = std::chrono::steady_clock::now ();
+	MazeBatchStats stats;
+	if (jobs.empty ()) {
+		return stats;
+	}
+
+	int workerCount = GetEffectiveThreadCount (threadCount, (int) std::min (jobs.size (), (size_t) std::numeric_limits<int>::max ()));
+	std::vector<BatchJobDeque> jobDeques (workerCount);
+	std::vector<bool> validJobs (jobs.size ());
+	for (size_t jobIndex = 0; jobIndex < jobs.size (); jobIndex++) {
+		validJobs[jobIndex] = IsValidBatchJob (jobs[jobIndex]);
+		jobDeques[jobIndex * workerCount / jobs.size ()].PushBack (jobIndex);
+	}
+
+	BatchResultQueue resultQueue (maxQueuedResultCount > 0 ? maxQueuedResultCount : (size_t) workerCount * 2, workerCount);
+	std::atomic<size_t> stolenJobCount (0);
+	auto worker = [&] (int workerIndex) {
+		Xoshiro256Engine randomEngine;
+		MemoryArena arena;
+		size_t jobIndex = 0;
+		bool stolen = false;
+		while (!resultQueue.IsStopped () && TakeBatchJob (jobDeques, workerIndex, jobIndex, stolen)) {
+			const MazeBatchJob& job = jobs[jobIndex];
+			auto jobStartTime = std::chrono::steady_clock::now ();
+			MazeBatchResult result;
+			result.jobIndex = jobIndex;
+			result.workerIndex = workerIndex;
+			if (validJobs[jobIndex]) {
+				arena.Reset ();
+				MazeAlgorithmPtr algorithm = CreateMazeAlgorithm (job.algorithmType, arena);
+				randomEngine.Seed (job.seed);
+				result.succeeded = (algorithm != nullptr && GenerateMaze (result.maze, job.rowCount, job.colCount, *algorithm, randomEngine));
+			}
+			result.generationMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - jobStartTime).count ();
+			if (stolen) {
+				stolenJobCount += 1;
+			}
+			if (!resultQueue.Push (result)) {
+				break;
+			}
+		}
+		resultQueue.FinishWorker ();
+	};
+
+	std::vector<std::thread> threads;
+	for (int workerIndex = 0; workerIndex < workerCount; workerIndex++) {
+		threads.push_back (std::thread (worker, workerIndex));
+	}
+
+	MazeBatchResult result;
+	while (resultQueue.Pop (result)) {
+		stats.completedJobCount += 1;
+		if (!resultCallback (result)) {
+			resultQueue.Stop ();
+			stats.stopped = true;
+			break;
+		}
+	}
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+
+	stats.workerCount = workerCount;
+	stats.stolenJobCount = stolenJobCount;
+	stats.totalMs = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - startTime).count ();
+	return stats;
+}
+
+}
@@ -0,0 +1,63 @@
+#ifndef MAZEBATCH_HPP
+#define MAZEBATCH_HPP
+
+#include "MazeGenerator.hpp"
+
+namespace MG
+{
+
+class MazeBatchJob
+{
+public:
+	MazeBatchJob ();
+	MazeBatchJob (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType);
+
+	int					rowCount;
+	int					colCount;
+	std::uint64_t		seed;
+	MazeAlgorithmType	algorithmType;
+};
+
+class MazeBatchResult
+{
+public:
+	MazeBatchResult ();
+
+	size_t	jobIndex;
+	bool	succeeded;
+	int		workerIndex;
+	double	generationMs;
+	Maze	maze;
+};
+
+class MazeBatchStats
+{
+public:
+	MazeBatchStats ();
+
+	bool	stopped;
+	int		workerCount;
+	size_t	completedJobCount;
+	size_t	stolenJobCount;
+	double	totalMs;
+};
+
+using MazeBatchResultCallback = std::function<bool (MazeBatchResult& result)>;
+
+class MazeBatchGenerator
+{
+public:
+	MazeBatchGenerator (int threadCount);
+
+	void			SetMaxQueuedResultCount (size_t newMaxQueuedResultCount);
+
+	MazeBatchStats	Run (const std::vector<MazeBatchJob>& jobs, const MazeBatchResultCallback& resultCallback);
+
+private:
+	int		threadCount;
+	size_t	maxQueuedResultCount;
+};
+
+}
+
+#endif
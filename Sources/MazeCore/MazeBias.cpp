@@ -0,0 +1,100 @@
+#include "MazeBias.hpp"
+#include "TextFile.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace MG
+{
+
+static std::uint32_t QuantizeWeight (double weight)
+{
+	double scaledWeight = std::round (weight * MazeBiasField::NeutralWeight);
+	return (std::uint32_t) std::min (std::max (scaledWeight, 1.0), 16777216.0);
+}
+
+const std::uint32_t MazeBiasField::NeutralWeight;
+
+MazeBiasField::MazeBiasField () :
+	rows (0),
+	cols (0),
+	horizontalWeights (),
+	verticalWeights ()
+{
+
+}
+
+MazeBiasField::MazeBiasField (int rowCount, int colCount) :
+	MazeBiasField ()
+{
+	Reset (rowCount, colCount);
+}
+
+void MazeBiasField::Reset (int rowCount, int colCount)
+{
+	rows = std::max (rowCount, 0);
+	cols = std::max (colCount, 0);
+	horizontalWeights.assign ((size_t) rows * cols, NeutralWeight);
+	verticalWeights.assign ((size_t) rows * cols, NeutralWeight);
+}
+
+void MazeBiasField::SetCellBias (int row, int col, double horizontalWeight, double verticalWeight)
+{
+	if (row < 0 || row >= rows || col < 0 || col >= cols) {
+		return;
+	}
+	horizontalWeights[(size_t) row * cols + col] = QuantizeWeight (horizontalWeight);
+	verticalWeights[(size_t) row * cols + col] = QuantizeWeight (verticalWeight);
+}
+
+int MazeBiasField::GetRowCount () const
+{
+	return rows;
+}
+
+int MazeBiasField::GetColCount () const
+{
+	return cols;
+}
+
+std::uint32_t MazeBiasField::GetHorizontalWeight (CellId cellId) const
+{
+	return horizontalWeights[cellId];
+}
+
+std::uint32_t MazeBiasField::GetVerticalWeight (CellId cellId) const
+{
+	return verticalWeights[cellId];
+}
+
+bool ReadMazeBiasFile (const std::string& path, int rowCount, int colCount, double corridorWeight, MazeBiasField& biasField)
+{
+	std::vector<std::string> lines;
+	if (!ReadTextLines (path, lines) || lines.empty () || rowCount <= 0 || colCount <= 0) {
+		return false;
+	}
+	size_t lineLength = 0;
+	for (const std::string& line : lines) {
+		lineLength = std::max (lineLength, line.size ());
+	}
+	if (lineLength == 0) {
+		return false;
+	}
+
+	biasField.Reset (rowCount, colCount);
+	for (int row = 0; row < rowCount; row++) {
+		const std::string& line = lines[(size_t) row * lines.size () / rowCount];
+		for (int col = 0; col < colCount; col++) {
+			size_t charIndex = (size_t) col * lineLength / colCount;
+			char bias = (charIndex < line.size () ? line[charIndex] : ' ');
+			if (bias == '-') {
+				biasField.SetCellBias (row, col, corridorWeight, 1.0);
+			} else if (bias == '|') {
+				biasField.SetCellBias (row, col, 1.0, corridorWeight);
+			}
+		}
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,38 @@
+#ifndef MAZEBIAS_HPP
+#define MAZEBIAS_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <string>
+
+namespace MG
+{
+
+class MazeBiasField
+{
+public:
+	static const std::uint32_t	NeutralWeight = 256;
+
+	MazeBiasField ();
+	MazeBiasField (int rowCount, int colCount);
+
+	void			Reset (int rowCount, int colCount);
+	void			SetCellBias (int row, int col, double horizontalWeight, double verticalWeight);
+
+	int				GetRowCount () const;
+	int				GetColCount () const;
+	std::uint32_t	GetHorizontalWeight (CellId cellId) const;
+	std::uint32_t	GetVerticalWeight (CellId cellId) const;
+
+private:
+	int							rows;
+	int							cols;
+	std::vector<std::uint32_t>	horizontalWeights;
+	std::vector<std::uint32_t>	verticalWeights;
+};
+
+bool	ReadMazeBiasFile (const std::string& path, int rowCount, int colCount, double corridorWeight, MazeBiasField& biasField);
+
+}
+
+#endif
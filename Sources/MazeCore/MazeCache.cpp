@@ -0,0 +1,262 @@
+#include "MazeCache.hpp"
+#include "MazeAlgorithms.hpp"
+#include "MazeFile.hpp"
+
+#include <exception>
+
+namespace MG
+{
+
+static size_t CombineHash (size_t hash, std::uint64_t value)
+{
+	return hash ^ (std::hash<std::uint64_t> () (value) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2));
+}
+
+static size_t GetMazeMemorySize (const Maze& maze)
+{
+	WallBitsView bits = maze.GetWallBits ();
+	size_t wordCount = (size_t) (bits.rowCount + 1) * bits.horizontalWordsPerLine + (size_t) (bits.colCount + 1) * bits.verticalWordsPerLine;
+	return sizeof (Maze) + wordCount * sizeof (std::uint64_t);
+}
+
+static bool ReadCachedMazeFile (const std::string& path, const MazeCacheKey& key, Maze& maze)
+{
+	MappedMazeFile mappedFile;
+	if (!mappedFile.Open (path, true)) {
+		return false;
+	}
+	const MazeFileHeader& header = mappedFile.GetHeader ();
+	if (header.rowCount != key.rowCount || header.colCount != key.colCount || header.seed != key.seed || header.algorithmType != (std::int32_t) key.algorithmType) {
+		return false;
+	}
+	return maze.SetWallBits (mappedFile.GetWallBits ());
+}
+
+MazeCacheKey::MazeCacheKey () :
+	MazeCacheKey (0, 0, 0, MazeAlgorithmType::Prim)
+{
+
+}
+
+MazeCacheKey::MazeCacheKey (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType) :
+	rowCount (rowCount),
+	colCount (colCount),
+	seed (seed),
+	algorithmType (algorithmType)
+{
+
+}
+
+bool MazeCacheKey::operator== (const MazeCacheKey& other) const
+{
+	return rowCount == other.rowCount && colCount == other.colCount && seed == other.seed && algorithmType == other.algorithmType;
+}
+
+size_t MazeCacheKeyHash::operator() (const MazeCacheKey& key) const
+{
+	size_t hash = 0;
+	hash = CombineHash (hash, (std::uint64_t) key.rowCount);
+	hash = CombineHash (hash, (std::uint64_t) key.colCount);
+	hash = CombineHash (hash, key.seed);
+	hash = CombineHash (hash, (std::uint64_t) key.algorithmType);
+	return hash;
+}
+
+MazeCacheStats::MazeCacheStats () :
+	memoryHitCount (0),
+	diskHitCount (0),
+	missCount (0),
+	evictionCount (0),
+	entryCount (0),
+	memoryUsage (0)
+{
+
+}
+
+MazeCache::Entry::Entry () :
+	key (),
+	maze (),
+	geometryCellSize (0.0),
+	geometries (),
+	memorySize (0)
+{
+
+}
+
+MazeCache::MazeCache (size_t memoryBudget) :
+	mutex (),
+	memoryBudget (memoryBudget),
+	diskDirectory (),
+	entries (),
+	entryMap (),
+	pendingMazes (),
+	stats ()
+{
+
+}
+
+void MazeCache::SetMemoryBudget (size_t newMemoryBudget)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	memoryBudget = newMemoryBudget;
+	EvictEntries ();
+}
+
+void MazeCache::SetDiskDirectory (const std::string& newDiskDirectory)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	diskDirectory = newDiskDirectory;
+}
+
+std::shared_ptr<const Maze> MazeCache::GetMaze (const MazeCacheKey& key)
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	auto found = entryMap.find (key);
+	if (found != entryMap.end ()) {
+		entries.splice (entries.begin (), entries, found->second);
+		stats.memoryHitCount += 1;
+		return found->second->maze;
+	}
+	auto pending = pendingMazes.find (key);
+	if (pending != pendingMazes.end ()) {
+		std::shared_future<std::shared_ptr<const Maze>> pendingMaze = pending->second;
+		stats.memoryHitCount += 1;
+		lock.unlock ();
+		return pendingMaze.get ();
+	}
+	std::promise<std::shared_ptr<const Maze>> mazePromise;
+	pendingMazes[key] = mazePromise.get_future ().share ();
+	lock.unlock ();
+
+	std::shared_ptr<const Maze> maze;
+	try {
+		maze = LoadOrGenerateMaze (key);
+	} catch (...) {
+		lock.lock ();
+		pendingMazes.erase (key);
+		lock.unlock ();
+		mazePromise.set_exception (std::current_exception ());
+		throw;
+	}
+
+	lock.lock ();
+	pendingMazes.erase (key);
+	if (maze != nullptr) {
+		entries.push_front (Entry ());
+		Entry& entry = entries.front ();
+		entry.key = key;
+		entry.maze = maze;
+		entryMap[key] = entries.begin ();
+		UpdateMemorySize (entry);
+		EvictEntries ();
+	}
+	lock.unlock ();
+	mazePromise.set_value (maze);
+	return maze;
+}
+
+std::shared_ptr<const std::vector<WallGeometry>> MazeCache::GetWallGeometries (const MazeCacheKey& key, double cellSize)
+{
+	std::shared_ptr<const Maze> maze = GetMaze (key);
+	if (maze == nullptr) {
+		return nullptr;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		auto found = entryMap.find (key);
+		if (found != entryMap.end () && found->second->geometries != nullptr && found->second->geometryCellSize == cellSize) {
+			return found->second->geometries;
+		}
+	}
+
+	std::shared_ptr<const std::vector<WallGeometry>> geometries = std::make_shared<const std::vector<WallGeometry>> (maze->GetWallGeometries (cellSize, 0));
+
+	std::lock_guard<std::mutex> lock (mutex);
+	auto found = entryMap.find (key);
+	if (found != entryMap.end () && found->second->memorySize + geometries->capacity () * sizeof (WallGeometry) <= memoryBudget) {
+		Entry& entry = *found->second;
+		entry.geometryCellSize = cellSize;
+		entry.geometries = geometries;
+		UpdateMemorySize (entry);
+		EvictEntries ();
+	}
+	return geometries;
+}
+
+MazeCacheStats MazeCache::GetStats () const
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	MazeCacheStats result = stats;
+	result.entryCount = entries.size ();
+	return result;
+}
+
+void MazeCache::Clear ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	entries.clear ();
+	entryMap.clear ();
+	stats.memoryUsage = 0;
+}
+
+std::shared_ptr<const Maze> MazeCache::LoadOrGenerateMaze (const MazeCacheKey& key)
+{
+	std::string diskPath;
+	{
+		std::lock_guard<std::mutex> lock (mutex);
+		diskPath = GetDiskPath (key);
+	}
+
+	std::shared_ptr<Maze> maze = std::make_shared<Maze> ();
+	if (!diskPath.empty () && ReadCachedMazeFile (diskPath, key, *maze)) {
+		std::lock_guard<std::mutex> lock (mutex);
+		stats.diskHitCount += 1;
+		return maze;
+	}
+
+	MazeGenerator generator (key.rowCount, key.colCount, key.seed, key.algorithmType);
+	if (!generator.Generate ()) {
+		return nullptr;
+	}
+	*maze = generator.GetMaze ();
+	if (!diskPath.empty ()) {
+		WriteMazeFile (diskPath, *maze, key.seed, key.algorithmType);
+	}
+
+	std::lock_guard<std::mutex> lock (mutex);
+	stats.missCount += 1;
+	return maze;
+}
+
+std::string MazeCache::GetDiskPath (const MazeCacheKey& key) const
+{
+	if (diskDirectory.empty ()) {
+		return std::string ();
+	}
+	return diskDirectory + "/maze_" + std::to_string (key.rowCount) + "x" + std::to_string (key.colCount) + "_" +
+		GetMazeAlgorithmName (key.algorithmType) + "_" + std::to_string (key.seed) + ".mgwb";
+}
+
+void MazeCache::UpdateMemorySize (Entry& entry)
+{
+	stats.memoryUsage -= entry.memorySize;
+	entry.memorySize = sizeof (Entry) + GetMazeMemorySize (*entry.maze);
+	if (entry.geometries != nullptr) {
+		entry.memorySize += entry.geometries->capacity () * sizeof (WallGeometry);
+	}
+	stats.memoryUsage += entry.memorySize;
+}
+
+void MazeCache::EvictEntries ()
+{
+	while (stats.memoryUsage > memoryBudget && !entries.empty ()) {
+		Entry& entry = entries.back ();
+		stats.memoryUsage -= entry.memorySize;
+		stats.evictionCount += 1;
+		entryMap.erase (entry.key);
+		entries.pop_back ();
+	}
+}
+
+}
@@ -0,0 +1,97 @@
+#ifndef MAZECACHE_HPP
+#define MAZECACHE_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace MG
+{
+
+class MazeCacheKey
+{
+public:
+	MazeCacheKey ();
+	MazeCacheKey (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType);
+
+	bool	operator== (const MazeCacheKey& other) const;
+
+	int					rowCount;
+	int					colCount;
+	std::uint64_t		seed;
+	MazeAlgorithmType	algorithmType;
+};
+
+class MazeCacheKeyHash
+{
+public:
+	size_t	operator() (const MazeCacheKey& key) const;
+};
+
+class MazeCacheStats
+{
+public:
+	MazeCacheStats ();
+
+	size_t	memoryHitCount;
+	size_t	diskHitCount;
+	size_t	missCount;
+	size_t	evictionCount;
+	size_t	entryCount;
+	size_t	memoryUsage;
+};
+
+class MazeCache
+{
+public:
+	static const size_t DefaultMemoryBudget = 256 * 1024 * 1024;
+
+	MazeCache (size_t memoryBudget = DefaultMemoryBudget);
+
+	void											SetMemoryBudget (size_t newMemoryBudget);
+	void											SetDiskDirectory (const std::string& newDiskDirectory);
+
+	std::shared_ptr<const Maze>						GetMaze (const MazeCacheKey& key);
+	std::shared_ptr<const std::vector<WallGeometry>>	GetWallGeometries (const MazeCacheKey& key, double cellSize);
+
+	MazeCacheStats									GetStats () const;
+	void											Clear ();
+
+private:
+	class Entry
+	{
+	public:
+		Entry ();
+
+		MazeCacheKey										key;
+		std::shared_ptr<const Maze>							maze;
+		double												geometryCellSize;
+		std::shared_ptr<const std::vector<WallGeometry>>	geometries;
+		size_t												memorySize;
+	};
+
+	using EntryList = std::list<Entry>;
+	using EntryMap = std::unordered_map<MazeCacheKey, EntryList::iterator, MazeCacheKeyHash>;
+	using PendingMazeMap = std::unordered_map<MazeCacheKey, std::shared_future<std::shared_ptr<const Maze>>, MazeCacheKeyHash>;
+
+	std::shared_ptr<const Maze>		LoadOrGenerateMaze (const MazeCacheKey& key);
+	std::string						GetDiskPath (const MazeCacheKey& key) const;
+	void							UpdateMemorySize (Entry& entry);
+	void							EvictEntries ();
+
+	mutable std::mutex	mutex;
+	size_t				memoryBudget;
+	std::string			diskDirectory;
+	EntryList			entries;
+	EntryMap			entryMap;
+	PendingMazeMap		pendingMazes;
+	MazeCacheStats		stats;
+};
+
+}
+
+#endif
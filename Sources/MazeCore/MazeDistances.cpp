@@ -0,0 +1,329 @@
+#include "MazeDistances.hpp"
+#include "MazeSolver.hpp"
+#include "WallBits.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+namespace MG
+{
+
+const std::uint32_t UnreachedDistance = std::numeric_limits<std::uint32_t>::max ();
+
+static const size_t TopDownToBottomUpFactor = 14;
+static const size_t BottomUpToTopDownFactor = 24;
+static const size_t TopDownParallelMinCellCount = 8192;
+static const size_t TopDownChunkCellCount = 2048;
+
+class DistanceSearch
+{
+public:
+	DistanceSearch (const std::vector<std::uint8_t>& passages, int colCount, int threadCount, DistanceField& field);
+
+	void	Run (CellId sourceCellId);
+
+private:
+	size_t	GetBlockBegWord (int blockIndex) const;
+	size_t	GetBlockEndWord (int blockIndex) const;
+	bool	TestBit (const std::vector<std::uint64_t>& bitSet, CellId cellId) const;
+	void	SetBit (std::vector<std::uint64_t>& bitSet, CellId cellId) const;
+	bool	TestVisited (CellId cellId) const;
+	bool	ClaimVisited (CellId cellId, bool concurrent);
+
+	void	VisitFrontierCells (size_t begIndex, size_t endIndex, std::uint32_t level, std::vector<CellId>& reachedCells, CellId& firstCellId, bool concurrent);
+	void	StepTopDown (std::uint32_t level);
+	void	StepBottomUp (std::uint32_t level);
+	void	FillFrontierBits ();
+	void	FillFrontierCells ();
+
+	const std::vector<std::uint8_t>&		passages;
+	int										colCount;
+	int										threadCount;
+	CellId									cellCount;
+	int										blockCount;
+	CellId									offsets[4];
+	DistanceField&							field;
+	std::vector<std::atomic<std::uint64_t>>	visitedBits;
+	std::vector<std::uint64_t>				frontierBits;
+	std::vector<std::uint64_t>				nextFrontierBits;
+	std::vector<CellId>						frontierCells;
+	std::vector<CellId>						nextFrontierCells;
+	std::vector<std::vector<CellId>>		workerFrontierCells;
+	std::vector<CellId>						workerFirstCellIds;
+	std::vector<size_t>						blockReachedCounts;
+	std::vector<CellId>						blockFirstCellIds;
+	size_t									frontierCount;
+	CellId									frontierFirstCellId;
+};
+
+DistanceSearch::DistanceSearch (const std::vector<std::uint8_t>& passages, int colCount, int threadCount, DistanceField& field) :
+	passages (passages),
+	colCount (colCount),
+	threadCount (threadCount),
+	cellCount ((CellId) passages.size ()),
+	blockCount (colCount > 0 ? (int) ((passages.size () / colCount + WallWordBits - 1) / WallWordBits) : 0),
+	offsets { -1, 1, -colCount, colCount },
+	field (field),
+	visitedBits ((passages.size () + WallWordBits - 1) / WallWordBits),
+	frontierBits (visitedBits.size (), 0),
+	nextFrontierBits (visitedBits.size (), 0),
+	frontierCells (),
+	nextFrontierCells (),
+	workerFrontierCells (),
+	workerFirstCellIds (),
+	blockReachedCounts (blockCount, 0),
+	blockFirstCellIds (blockCount, InvalidCellId),
+	frontierCount (0),
+	frontierFirstCellId (InvalidCellId)
+{
+
+}
+
+void DistanceSearch::Run (CellId sourceCellId)
+{
+	field.distances[sourceCellId] = 0;
+	field.farthestCellId = sourceCellId;
+	field.maxDistance = 0;
+	field.reachedCellCount = 1;
+	ClaimVisited (sourceCellId, false);
+	frontierCells.push_back (sourceCellId);
+	frontierCount = 1;
+
+	bool bottomUp = false;
+	for (std::uint32_t level = 0; frontierCount > 0; level++) {
+		size_t unvisitedCount = (size_t) cellCount - field.reachedCellCount;
+		bool preferBottomUp = (frontierCount * TopDownToBottomUpFactor > unvisitedCount);
+		if (!bottomUp && preferBottomUp) {
+			FillFrontierBits ();
+			bottomUp = true;
+		} else if (bottomUp && !preferBottomUp && frontierCount * BottomUpToTopDownFactor < (size_t) cellCount) {
+			FillFrontierCells ();
+			bottomUp = false;
+		}
+
+		if (bottomUp) {
+			StepBottomUp (level);
+			field.bottomUpLevelCount += 1;
+		} else {
+			StepTopDown (level);
+			field.topDownLevelCount += 1;
+		}
+		if (frontierCount > 0) {
+			field.farthestCellId = frontierFirstCellId;
+			field.maxDistance = level + 1;
+			field.reachedCellCount += frontierCount;
+		}
+	}
+}
+
+size_t DistanceSearch::GetBlockBegWord (int blockIndex) const
+{
+	return (size_t) blockIndex * colCount;
+}
+
+size_t DistanceSearch::GetBlockEndWord (int blockIndex) const
+{
+	return std::min ((size_t) (blockIndex + 1) * colCount, visitedBits.size ());
+}
+
+bool DistanceSearch::TestBit (const std::vector<std::uint64_t>& bitSet, CellId cellId) const
+{
+	return ((bitSet[cellId / WallWordBits] >> (cellId % WallWordBits)) & 1) != 0;
+}
+
+void DistanceSearch::SetBit (std::vector<std::uint64_t>& bitSet, CellId cellId) const
+{
+	bitSet[cellId / WallWordBits] |= (std::uint64_t) 1 << (cellId % WallWordBits);
+}
+
+bool DistanceSearch::TestVisited (CellId cellId) const
+{
+	return ((visitedBits[cellId / WallWordBits].load (std::memory_order_relaxed) >> (cellId % WallWordBits)) & 1) != 0;
+}
+
+bool DistanceSearch::ClaimVisited (CellId cellId, bool concurrent)
+{
+	std::atomic<std::uint64_t>& visitedWord = visitedBits[cellId / WallWordBits];
+	std::uint64_t cellBit = (std::uint64_t) 1 << (cellId % WallWordBits);
+	if (concurrent) {
+		return (visitedWord.fetch_or (cellBit, std::memory_order_relaxed) & cellBit) == 0;
+	}
+	std::uint64_t word = visitedWord.load (std::memory_order_relaxed);
+	visitedWord.store (word | cellBit, std::memory_order_relaxed);
+	return (word & cellBit) == 0;
+}
+
+void DistanceSearch::VisitFrontierCells (size_t begIndex, size_t endIndex, std::uint32_t level, std::vector<CellId>& reachedCells, CellId& firstCellId, bool concurrent)
+{
+	for (size_t frontierIndex = begIndex; frontierIndex < endIndex; frontierIndex++) {
+		CellId cellId = frontierCells[frontierIndex];
+		std::uint8_t cellPassages = passages[cellId] & PassageMask;
+		while (cellPassages != 0) {
+			CellId nextCellId = cellId + offsets[CountTrailingZeros (cellPassages)];
+			cellPassages &= cellPassages - 1;
+			if (TestVisited (nextCellId) || !ClaimVisited (nextCellId, concurrent)) {
+				continue;
+			}
+			field.distances[nextCellId] = level + 1;
+			reachedCells.push_back (nextCellId);
+			firstCellId = std::min (firstCellId, nextCellId);
+		}
+	}
+}
+
+void DistanceSearch::StepTopDown (std::uint32_t level)
+{
+	nextFrontierCells.clear ();
+	frontierFirstCellId = cellCount;
+	int chunkCount = (int) ((frontierCells.size () + TopDownChunkCellCount - 1) / TopDownChunkCellCount);
+	int workerCount = GetEffectiveThreadCount (threadCount, chunkCount);
+	if (frontierCells.size () < TopDownParallelMinCellCount || workerCount == 1) {
+		VisitFrontierCells (0, frontierCells.size (), level, nextFrontierCells, frontierFirstCellId, false);
+	} else {
+		if (workerFrontierCells.size () < (size_t) workerCount) {
+			workerFrontierCells.resize (workerCount);
+			workerFirstCellIds.resize (workerCount);
+		}
+		for (int workerIndex = 0; workerIndex < workerCount; workerIndex++) {
+			workerFrontierCells[workerIndex].clear ();
+			workerFirstCellIds[workerIndex] = cellCount;
+		}
+		ParallelFor (chunkCount, workerCount, [&] (int chunkIndex, int workerIndex) {
+			size_t begIndex = (size_t) chunkIndex * TopDownChunkCellCount;
+			size_t endIndex = std::min (begIndex + TopDownChunkCellCount, frontierCells.size ());
+			VisitFrontierCells (begIndex, endIndex, level, workerFrontierCells[workerIndex], workerFirstCellIds[workerIndex], true);
+		});
+		for (int workerIndex = 0; workerIndex < workerCount; workerIndex++) {
+			nextFrontierCells.insert (nextFrontierCells.end (), workerFrontierCells[workerIndex].begin (), workerFrontierCells[workerIndex].end ());
+			frontierFirstCellId = std::min (frontierFirstCellId, workerFirstCellIds[workerIndex]);
+		}
+	}
+	frontierCells.swap (nextFrontierCells);
+	frontierCount = frontierCells.size ();
+}
+
+void DistanceSearch::StepBottomUp (std::uint32_t level)
+{
+	ParallelFor (blockCount, threadCount, [&] (int blockIndex, int) {
+		size_t reachedCount = 0;
+		CellId firstCellId = InvalidCellId;
+		for (size_t wordIndex = GetBlockBegWord (blockIndex); wordIndex < GetBlockEndWord (blockIndex); wordIndex++) {
+			CellId wordBegCellId = (CellId) (wordIndex * WallWordBits);
+			std::uint64_t visitedWord = visitedBits[wordIndex].load (std::memory_order_relaxed);
+			std::uint64_t unvisitedBits = ~visitedWord;
+			if (cellCount - wordBegCellId < WallWordBits) {
+				unvisitedBits &= ((std::uint64_t) 1 << (cellCount - wordBegCellId)) - 1;
+			}
+			std::uint64_t reachedBits = 0;
+			while (unvisitedBits != 0) {
+				int bitIndex = CountTrailingZeros (unvisitedBits);
+				unvisitedBits &= unvisitedBits - 1;
+				CellId cellId = wordBegCellId + bitIndex;
+				std::uint8_t cellPassages = passages[cellId] & PassageMask;
+				while (cellPassages != 0) {
+					CellId neighbourCellId = cellId + offsets[CountTrailingZeros (cellPassages)];
+					cellPassages &= cellPassages - 1;
+					if (TestBit (frontierBits, neighbourCellId)) {
+						reachedBits |= (std::uint64_t) 1 << bitIndex;
+						field.distances[cellId] = level + 1;
+						break;
+					}
+				}
+			}
+			if (reachedBits != 0 && firstCellId == InvalidCellId) {
+				firstCellId = wordBegCellId + CountTrailingZeros (reachedBits);
+			}
+			visitedBits[wordIndex].store (visitedWord | reachedBits, std::memory_order_relaxed);
+			nextFrontierBits[wordIndex] = reachedBits;
+			reachedCount += CountBits (reachedBits);
+		}
+		blockReachedCounts[blockIndex] = reachedCount;
+		blockFirstCellIds[blockIndex] = firstCellId;
+	});
+
+	frontierBits.swap (nextFrontierBits);
+	frontierCount = 0;
+	frontierFirstCellId = InvalidCellId;
+	for (int blockIndex = 0; blockIndex < blockCount; blockIndex++) {
+		frontierCount += blockReachedCounts[blockIndex];
+		if (frontierFirstCellId == InvalidCellId) {
+			frontierFirstCellId = blockFirstCellIds[blockIndex];
+		}
+	}
+}
+
+void DistanceSearch::FillFrontierBits ()
+{
+	std::fill (frontierBits.begin (), frontierBits.end (), 0);
+	for (CellId cellId : frontierCells) {
+		SetBit (frontierBits, cellId);
+	}
+}
+
+void DistanceSearch::FillFrontierCells ()
+{
+	frontierCells.clear ();
+	for (size_t wordIndex = 0; wordIndex < frontierBits.size (); wordIndex++) {
+		std::uint64_t word = frontierBits[wordIndex];
+		while (word != 0) {
+			frontierCells.push_back ((CellId) (wordIndex * WallWordBits) + CountTrailingZeros (word));
+			word &= word - 1;
+		}
+	}
+}
+
+DistanceField::DistanceField () :
+	rowCount (0),
+	colCount (0),
+	distances (),
+	farthestCellId (InvalidCellId),
+	maxDistance (0),
+	reachedCellCount (0),
+	topDownLevelCount (0),
+	bottomUpLevelCount (0)
+{
+
+}
+
+MazeDiameter::MazeDiameter () :
+	begCellId (InvalidCellId),
+	endCellId (InvalidCellId),
+	length (0)
+{
+
+}
+
+DistanceField ComputeDistanceField (const WallBitsView& bits, CellId sourceCellId, int threadCount)
+{
+	DistanceField field;
+	field.rowCount = bits.rowCount;
+	field.colCount = bits.colCount;
+	field.distances.assign ((size_t) bits.rowCount * bits.colCount, UnreachedDistance);
+	if (sourceCellId < 0 || sourceCellId >= (CellId) field.distances.size ()) {
+		return field;
+	}
+
+	std::vector<std::uint8_t> passages;
+	BuildCellPassages (bits, passages, threadCount);
+	DistanceSearch search (passages, bits.colCount, threadCount, field);
+	search.Run (sourceCellId);
+	return field;
+}
+
+MazeDiameter ComputeMazeDiameter (const WallBitsView& bits, int threadCount)
+{
+	MazeDiameter diameter;
+	DistanceField firstSweep = ComputeDistanceField (bits, 0, threadCount);
+	if (firstSweep.farthestCellId == InvalidCellId) {
+		return diameter;
+	}
+	DistanceField secondSweep = ComputeDistanceField (bits, firstSweep.farthestCellId, threadCount);
+	diameter.begCellId = firstSweep.farthestCellId;
+	diameter.endCellId = secondSweep.farthestCellId;
+	diameter.length = secondSweep.maxDistance;
+	return diameter;
+}
+
+}
@@ -0,0 +1,41 @@
+#ifndef MAZEDISTANCES_HPP
+#define MAZEDISTANCES_HPP
+
+#include "MazeGenerator.hpp"
+
+namespace MG
+{
+
+extern const std::uint32_t UnreachedDistance;
+
+class DistanceField
+{
+public:
+	DistanceField ();
+
+	int							rowCount;
+	int							colCount;
+	std::vector<std::uint32_t>	distances;
+	CellId						farthestCellId;
+	std::uint32_t				maxDistance;
+	size_t						reachedCellCount;
+	int							topDownLevelCount;
+	int							bottomUpLevelCount;
+};
+
+class MazeDiameter
+{
+public:
+	MazeDiameter ();
+
+	CellId			begCellId;
+	CellId			endCellId;
+	std::uint32_t	length;
+};
+
+DistanceField	ComputeDistanceField (const WallBitsView& bits, CellId sourceCellId, int threadCount);
+MazeDiameter	ComputeMazeDiameter (const WallBitsView& bits, int threadCount);
+
+}
+
+#endif
@@ -0,0 +1,314 @@
+#include "MazeFile.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+#if defined (_WIN32)
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace MG
+{
+
+static const char MazeFileMagic[4] = { 'M', 'G', 'W', 'B' };
+static const std::uint32_t MazeFileByteOrderMark = 0x01020304;
+static const std::int32_t UnknownAlgorithmType = -1;
+
+static_assert (sizeof (MazeFileHeader) % sizeof (std::uint64_t) == 0, "Wall words must stay aligned after the header.");
+
+static std::atomic<std::uint64_t> tempFileCounter (0);
+
+static std::uint64_t MixChecksum (std::uint64_t checksum, std::uint64_t word)
+{
+	checksum ^= word + 0x9e3779b97f4a7c15ULL + (checksum << 6) + (checksum >> 2);
+	return checksum * 0xff51afd7ed558ccdULL;
+}
+
+static std::uint64_t ComputeWordsChecksum (std::uint64_t checksum, const std::uint64_t* words, size_t wordCount)
+{
+	std::uint64_t lanes[4] = { checksum, checksum + 1, checksum + 2, checksum + 3 };
+	size_t i = 0;
+	for (; i + 4 <= wordCount; i += 4) {
+		lanes[0] = MixChecksum (lanes[0], words[i]);
+		lanes[1] = MixChecksum (lanes[1], words[i + 1]);
+		lanes[2] = MixChecksum (lanes[2], words[i + 2]);
+		lanes[3] = MixChecksum (lanes[3], words[i + 3]);
+	}
+	for (; i < wordCount; i++) {
+		lanes[0] = MixChecksum (lanes[0], words[i]);
+	}
+	return MixChecksum (MixChecksum (MixChecksum (lanes[0], lanes[1]), lanes[2]), lanes[3]);
+}
+
+static size_t GetHorizontalWordCount (const WallBitsView& bits)
+{
+	return (size_t) (bits.rowCount + 1) * bits.horizontalWordsPerLine;
+}
+
+static size_t GetVerticalWordCount (const WallBitsView& bits)
+{
+	return (size_t) (bits.colCount + 1) * bits.verticalWordsPerLine;
+}
+
+static bool HasClearTailBits (const std::uint64_t* words, int lineCount, int wordsPerLine, int lineLength)
+{
+	int tailBits = lineLength % WallWordBits;
+	if (tailBits == 0) {
+		return true;
+	}
+	std::uint64_t tailMask = ~(((std::uint64_t) 1 << tailBits) - 1);
+	for (int line = 0; line < lineCount; line++) {
+		if ((words[(size_t) line * wordsPerLine + wordsPerLine - 1] & tailMask) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool WriteValue (std::FILE* file, const void* data, size_t size)
+{
+	return size == 0 || std::fwrite (data, size, 1, file) == 1;
+}
+
+MazeFileHeader::MazeFileHeader () :
+	magic (),
+	version (MazeFileVersion),
+	byteOrderMark (MazeFileByteOrderMark),
+	rowCount (0),
+	colCount (0),
+	algorithmType (UnknownAlgorithmType),
+	seed (0),
+	horizontalWordCount (0),
+	verticalWordCount (0),
+	checksum (0),
+	reserved (0)
+{
+	std::memcpy (magic, MazeFileMagic, sizeof (magic));
+}
+
+MappedMazeFile::MappedMazeFile () :
+	header (nullptr),
+	data (nullptr),
+	size (0),
+#if defined (_WIN32)
+	fileHandle (INVALID_HANDLE_VALUE),
+	mappingHandle (nullptr)
+#else
+	fileDescriptor (-1)
+#endif
+{
+
+}
+
+MappedMazeFile::~MappedMazeFile ()
+{
+	Close ();
+}
+
+bool MappedMazeFile::Open (const std::string& path, bool verifyChecksum)
+{
+	Close ();
+
+#if defined (_WIN32)
+	fileHandle = CreateFileA (path.c_str (), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx (fileHandle, &fileSize) || fileSize.QuadPart < (LONGLONG) sizeof (MazeFileHeader)) {
+		Close ();
+		return false;
+	}
+	size = (size_t) fileSize.QuadPart;
+	mappingHandle = CreateFileMappingA (fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mappingHandle == nullptr) {
+		Close ();
+		return false;
+	}
+	data = MapViewOfFile (mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr) {
+		Close ();
+		return false;
+	}
+#else
+	fileDescriptor = open (path.c_str (), O_RDONLY);
+	if (fileDescriptor < 0) {
+		return false;
+	}
+	struct stat fileStat;
+	if (fstat (fileDescriptor, &fileStat) != 0 || fileStat.st_size < (off_t) sizeof (MazeFileHeader)) {
+		Close ();
+		return false;
+	}
+	size = (size_t) fileStat.st_size;
+	void* mapped = mmap (nullptr, size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+	if (mapped == MAP_FAILED) {
+		Close ();
+		return false;
+	}
+	data = mapped;
+#endif
+
+	header = static_cast<const MazeFileHeader*> (data);
+	WallBitsView bits = GetWallBits ();
+	bool valid =
+		std::memcmp (header->magic, MazeFileMagic, sizeof (MazeFileMagic)) == 0 &&
+		header->version == MazeFileVersion &&
+		header->byteOrderMark == MazeFileByteOrderMark &&
+		header->rowCount >= 0 && header->colCount >= 0 &&
+		header->horizontalWordCount == GetHorizontalWordCount (bits) &&
+		header->verticalWordCount == GetVerticalWordCount (bits) &&
+		size == sizeof (MazeFileHeader) + (header->horizontalWordCount + header->verticalWordCount) * sizeof (std::uint64_t) &&
+		HasClearTailBits (bits.horizontalBits, bits.rowCount + 1, bits.horizontalWordsPerLine, bits.colCount) &&
+		HasClearTailBits (bits.verticalBits, bits.colCount + 1, bits.verticalWordsPerLine, bits.rowCount);
+	if (!valid || (verifyChecksum && !VerifyChecksum ())) {
+		Close ();
+		return false;
+	}
+	return true;
+}
+
+void MappedMazeFile::Close ()
+{
+#if defined (_WIN32)
+	if (data != nullptr) {
+		UnmapViewOfFile (data);
+	}
+	if (mappingHandle != nullptr) {
+		CloseHandle (mappingHandle);
+	}
+	if (fileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle (fileHandle);
+	}
+	mappingHandle = nullptr;
+	fileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (data != nullptr) {
+		munmap (const_cast<void*> (data), size);
+	}
+	if (fileDescriptor >= 0) {
+		close (fileDescriptor);
+	}
+	fileDescriptor = -1;
+#endif
+	header = nullptr;
+	data = nullptr;
+	size = 0;
+}
+
+bool MappedMazeFile::IsOpen () const
+{
+	return header != nullptr;
+}
+
+bool MappedMazeFile::VerifyChecksum () const
+{
+	return header != nullptr && ComputeWallBitsChecksum (GetWallBits ()) == header->checksum;
+}
+
+const MazeFileHeader& MappedMazeFile::GetHeader () const
+{
+	return *header;
+}
+
+WallBitsView MappedMazeFile::GetWallBits () const
+{
+	WallBitsView bits;
+	if (header == nullptr) {
+		return bits;
+	}
+	const std::uint64_t* words = reinterpret_cast<const std::uint64_t*> (header + 1);
+	bits.rowCount = header->rowCount;
+	bits.colCount = header->colCount;
+	bits.horizontalWordsPerLine = (header->colCount + WallWordBits - 1) / WallWordBits;
+	bits.verticalWordsPerLine = (header->rowCount + WallWordBits - 1) / WallWordBits;
+	bits.horizontalBits = words;
+	bits.verticalBits = words + header->horizontalWordCount;
+	return bits;
+}
+
+std::uint64_t ComputeWallBitsChecksum (const WallBitsView& bits)
+{
+	std::uint64_t checksum = MixChecksum ((std::uint64_t) bits.rowCount, (std::uint64_t) bits.colCount);
+	checksum = ComputeWordsChecksum (checksum, bits.horizontalBits, GetHorizontalWordCount (bits));
+	return ComputeWordsChecksum (checksum, bits.verticalBits, GetVerticalWordCount (bits));
+}
+
+static std::string GetTempFilePath (const std::string& path)
+{
+#if defined (_WIN32)
+	unsigned long processId = (unsigned long) GetCurrentProcessId ();
+#else
+	unsigned long processId = (unsigned long) getpid ();
+#endif
+	return path + "." + std::to_string (processId) + "." + std::to_string (tempFileCounter.fetch_add (1)) + ".tmp";
+}
+
+static bool RenameTempFile (const std::string& sourcePath, const std::string& targetPath)
+{
+#if defined (_WIN32)
+	return MoveFileExA (sourcePath.c_str (), targetPath.c_str (), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	return std::rename (sourcePath.c_str (), targetPath.c_str ()) == 0;
+#endif
+}
+
+static bool WriteMazeFile (const std::string& path, const Maze& maze, MazeFileHeader& header)
+{
+	std::string tempPath = GetTempFilePath (path);
+	std::FILE* file = std::fopen (tempPath.c_str (), "wb");
+	if (file == nullptr) {
+		return false;
+	}
+
+	WallBitsView bits = maze.GetWallBits ();
+	header.rowCount = bits.rowCount;
+	header.colCount = bits.colCount;
+	header.horizontalWordCount = GetHorizontalWordCount (bits);
+	header.verticalWordCount = GetVerticalWordCount (bits);
+	header.checksum = ComputeWallBitsChecksum (bits);
+	bool succeeded =
+		WriteValue (file, &header, sizeof (header)) &&
+		WriteValue (file, bits.horizontalBits, header.horizontalWordCount * sizeof (std::uint64_t)) &&
+		WriteValue (file, bits.verticalBits, header.verticalWordCount * sizeof (std::uint64_t));
+	succeeded = (std::fclose (file) == 0) && succeeded;
+
+	if (succeeded) {
+		succeeded = RenameTempFile (tempPath, path);
+	}
+	if (!succeeded) {
+		std::remove (tempPath.c_str ());
+	}
+	return succeeded;
+}
+
+bool WriteMazeFile (const std::string& path, const Maze& maze)
+{
+	MazeFileHeader header;
+	return WriteMazeFile (path, maze, header);
+}
+
+bool WriteMazeFile (const std::string& path, const Maze& maze, std::uint64_t seed, MazeAlgorithmType algorithmType)
+{
+	MazeFileHeader header;
+	header.seed = seed;
+	header.algorithmType = (std::int32_t) algorithmType;
+	return WriteMazeFile (path, maze, header);
+}
+
+bool ReadMazeFile (const std::string& path, Maze& maze)
+{
+	MappedMazeFile mappedFile;
+	if (!mappedFile.Open (path, true)) {
+		return false;
+	}
+	return maze.SetWallBits (mappedFile.GetWallBits ());
+}
+
+}
@@ -0,0 +1,67 @@
+#ifndef MAZEFILE_HPP
+#define MAZEFILE_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <string>
+
+namespace MG
+{
+
+static const std::uint32_t MazeFileVersion = 2;
+
+class MazeFileHeader
+{
+public:
+	MazeFileHeader ();
+
+	char			magic[4];
+	std::uint32_t	version;
+	std::uint32_t	byteOrderMark;
+	std::int32_t	rowCount;
+	std::int32_t	colCount;
+	std::int32_t	algorithmType;
+	std::uint64_t	seed;
+	std::uint64_t	horizontalWordCount;
+	std::uint64_t	verticalWordCount;
+	std::uint64_t	checksum;
+	std::uint64_t	reserved;
+};
+
+class MappedMazeFile
+{
+public:
+	MappedMazeFile ();
+	MappedMazeFile (const MappedMazeFile&) = delete;
+	MappedMazeFile& operator= (const MappedMazeFile&) = delete;
+	~MappedMazeFile ();
+
+	bool					Open (const std::string& path, bool verifyChecksum);
+	void					Close ();
+	bool					IsOpen () const;
+	bool					VerifyChecksum () const;
+
+	const MazeFileHeader&	GetHeader () const;
+	WallBitsView			GetWallBits () const;
+
+private:
+	const MazeFileHeader*	header;
+	const void*				data;
+	size_t					size;
+#if defined (_WIN32)
+	void*					fileHandle;
+	void*					mappingHandle;
+#else
+	int						fileDescriptor;
+#endif
+};
+
+std::uint64_t	ComputeWallBitsChecksum (const WallBitsView& bits);
+
+bool			WriteMazeFile (const std::string& path, const Maze& maze);
+bool			WriteMazeFile (const std::string& path, const Maze& maze, std::uint64_t seed, MazeAlgorithmType algorithmType);
+bool			ReadMazeFile (const std::string& path, Maze& maze);
+
+}
+
+#endif
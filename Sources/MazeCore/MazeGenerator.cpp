@@ -0,0 +1,640 @@
+#include "MazeGenerator.hpp"
+#include "MazeAlgorithms.hpp"
+#include "CellMask.hpp"
+#include "MazeBias.hpp"
+#include "WallBits.hpp"
+
+#include <algorithm>
+
+namespace MG
+{
+
+const CellId InvalidCellId = -1;
+const WallId InvalidWallId = -1;
+
+static int GetWordCount (int bitCount)
+{
+	return (bitCount + WallWordBits - 1) / WallWordBits;
+}
+
+static void FillLines (ArenaVector<std::uint64_t>& lines, int lineCount, int wordsPerLine, int lineLength)
+{
+	lines.assign ((size_t) lineCount * wordsPerLine, ~(std::uint64_t) 0);
+	int tailBits = lineLength % WallWordBits;
+	if (tailBits == 0) {
+		return;
+	}
+	std::uint64_t tailMask = ((std::uint64_t) 1 << tailBits) - 1;
+	for (int line = 0; line < lineCount; line++) {
+		lines[(size_t) line * wordsPerLine + wordsPerLine - 1] = tailMask;
+	}
+}
+
+static void CopyLines (ArenaVector<std::uint64_t>& lines, const std::uint64_t* source, int lineCount, int wordsPerLine, int lineLength)
+{
+	lines.assign (source, source + (size_t) lineCount * wordsPerLine);
+	int tailBits = lineLength % WallWordBits;
+	if (tailBits == 0) {
+		return;
+	}
+	std::uint64_t tailMask = ((std::uint64_t) 1 << tailBits) - 1;
+	for (int line = 0; line < lineCount; line++) {
+		lines[(size_t) line * wordsPerLine + wordsPerLine - 1] &= tailMask;
+	}
+}
+
+static bool TestBit (const ArenaVector<std::uint64_t>& lines, int wordsPerLine, int line, int position)
+{
+	std::uint64_t word = lines[(size_t) line * wordsPerLine + position / WallWordBits];
+	return ((word >> (position % WallWordBits)) & 1) != 0;
+}
+
+static void SetBit (ArenaVector<std::uint64_t>& lines, int wordsPerLine, int line, int position, bool value)
+{
+	std::uint64_t& word = lines[(size_t) line * wordsPerLine + position / WallWordBits];
+	std::uint64_t mask = (std::uint64_t) 1 << (position % WallWordBits);
+	if (value) {
+		word |= mask;
+	} else {
+		word &= ~mask;
+	}
+}
+
+static size_t GetDirectionIndex (Direction dir)
+{
+	switch (dir) {
+	case Direction::Left:
+		return 0;
+	case Direction::Right:
+		return 1;
+	case Direction::Top:
+		return 2;
+	case Direction::Bottom:
+		return 3;
+	default:
+		return (size_t) -1;
+	}
+}
+
+CancellationToken::CancellationToken () :
+	cancelled (false)
+{
+
+}
+
+void CancellationToken::Cancel ()
+{
+	cancelled.store (true);
+}
+
+bool CancellationToken::IsCancelled () const
+{
+	return cancelled.load ();
+}
+
+Cell::Cell () :
+	walls { InvalidWallId, InvalidWallId, InvalidWallId, InvalidWallId }
+{
+
+}
+
+bool Cell::HasWall (Direction dir) const
+{
+	size_t index = GetDirectionIndex (dir);
+	if (index >= 4) {
+		return false;
+	}
+	return walls[index] != InvalidWallId;
+}
+
+WallId Cell::GetWall (Direction dir) const
+{
+	size_t index = GetDirectionIndex (dir);
+	if (index >= 4) {
+		return InvalidWallId;
+	}
+	return walls[index];
+}
+
+void Cell::EnumerateWalls (const std::function<void (WallId)>& processor) const
+{
+	for (WallId wallId : walls) {
+		if (wallId != InvalidWallId) {
+			processor (wallId);
+		}
+	}
+}
+
+void Cell::AddWall (Direction dir, WallId wallId)
+{
+	size_t index = GetDirectionIndex (dir);
+	if (index >= 4) {
+		return;
+	}
+	walls[index] = wallId;
+}
+
+void Cell::RemoveWall (WallId wallId)
+{
+	for (size_t i = 0; i < 4; i++) {
+		if (walls[i] == wallId) {
+			walls[i] = InvalidWallId;
+		}
+	}
+}
+
+Wall::Wall () :
+	Wall (InvalidCellId, InvalidCellId)
+{
+
+}
+
+Wall::Wall (CellId cellId1, CellId cellId2) :
+	cellId1 (cellId1),
+	cellId2 (cellId2)
+{
+
+}
+
+CellId Wall::GetCellId1 () const
+{
+	return cellId1;
+}
+
+CellId Wall::GetCellId2 () const
+{
+	return cellId2;
+}
+
+CellId Wall::GetOtherCellId (CellId cellId) const
+{
+	if (cellId == cellId1) {
+		return cellId2;
+	} else if (cellId == cellId2) {
+		return cellId1;
+	}
+	return InvalidCellId;
+}
+
+WallGeometry::WallGeometry () :
+	WallGeometry (0.0, 0.0, 0.0, 0.0)
+{
+
+}
+
+WallGeometry::WallGeometry (double begX, double begY, double endX, double endY) :
+	begX (begX),
+	begY (begY),
+	endX (endX),
+	endY (endY)
+{
+
+}
+
+WallBitsView::WallBitsView () :
+	rowCount (0),
+	colCount (0),
+	horizontalWordsPerLine (0),
+	verticalWordsPerLine (0),
+	horizontalBits (nullptr),
+	verticalBits (nullptr)
+{
+
+}
+
+Maze::Maze () :
+	rows (0),
+	cols (0),
+	horizontalWordsPerLine (0),
+	verticalWordsPerLine (0),
+	horizontalWalls (),
+	verticalWalls ()
+{
+
+}
+
+Maze::Maze (MemoryArena& arena) :
+	rows (0),
+	cols (0),
+	horizontalWordsPerLine (0),
+	verticalWordsPerLine (0),
+	horizontalWalls (ArenaAllocator<std::uint64_t> (&arena)),
+	verticalWalls (ArenaAllocator<std::uint64_t> (&arena))
+{
+
+}
+
+Maze::Maze (int rowCount, int colCount) :
+	Maze ()
+{
+	Reset (rowCount, colCount);
+}
+
+void Maze::Reset (int rowCount, int colCount)
+{
+	rows = rowCount;
+	cols = colCount;
+	horizontalWordsPerLine = GetWordCount (cols);
+	verticalWordsPerLine = GetWordCount (rows);
+	FillLines (horizontalWalls, rows + 1, horizontalWordsPerLine, cols);
+	FillLines (verticalWalls, cols + 1, verticalWordsPerLine, rows);
+}
+
+void Maze::Reset (const CellMask& cellMask)
+{
+	rows = cellMask.GetRowCount ();
+	cols = cellMask.GetColCount ();
+	horizontalWordsPerLine = GetWordCount (cols);
+	verticalWordsPerLine = GetWordCount (rows);
+	horizontalWalls.assign ((size_t) (rows + 1) * horizontalWordsPerLine, 0);
+	verticalWalls.assign ((size_t) (cols + 1) * verticalWordsPerLine, 0);
+	for (int row = 0; row < rows; row++) {
+		const std::uint64_t* rowBits = cellMask.GetRowBits (row);
+		std::uint64_t* topLine = horizontalWalls.data () + (size_t) row * horizontalWordsPerLine;
+		std::uint64_t* bottomLine = topLine + horizontalWordsPerLine;
+		std::uint64_t rowBit = (std::uint64_t) 1 << (row % WallWordBits);
+		for (int wordIndex = 0; wordIndex < horizontalWordsPerLine; wordIndex++) {
+			std::uint64_t word = rowBits[wordIndex];
+			topLine[wordIndex] |= word;
+			bottomLine[wordIndex] |= word;
+			while (word != 0) {
+				int col = wordIndex * WallWordBits + CountTrailingZeros (word);
+				std::uint64_t* leftWord = verticalWalls.data () + (size_t) col * verticalWordsPerLine + row / WallWordBits;
+				leftWord[0] |= rowBit;
+				leftWord[verticalWordsPerLine] |= rowBit;
+				word &= word - 1;
+			}
+		}
+	}
+}
+
+bool Maze::SetWallBits (const WallBitsView& bits)
+{
+	if (bits.rowCount < 0 || bits.colCount < 0 || bits.horizontalWordsPerLine != GetWordCount (bits.colCount) || bits.verticalWordsPerLine != GetWordCount (bits.rowCount)) {
+		return false;
+	}
+	rows = bits.rowCount;
+	cols = bits.colCount;
+	horizontalWordsPerLine = bits.horizontalWordsPerLine;
+	verticalWordsPerLine = bits.verticalWordsPerLine;
+	CopyLines (horizontalWalls, bits.horizontalBits, rows + 1, horizontalWordsPerLine, cols);
+	CopyLines (verticalWalls, bits.verticalBits, cols + 1, verticalWordsPerLine, rows);
+	return true;
+}
+
+bool Maze::CopyTileWalls (const Maze& tileMaze, int begRow, int begCol)
+{
+	if (begRow < 0 || begCol < 0 || begRow % WallWordBits != 0 || begCol % WallWordBits != 0) {
+		return false;
+	}
+	if (begRow + tileMaze.rows > rows || begCol + tileMaze.cols > cols) {
+		return false;
+	}
+	if ((tileMaze.rows % WallWordBits != 0 && begRow + tileMaze.rows != rows) || (tileMaze.cols % WallWordBits != 0 && begCol + tileMaze.cols != cols)) {
+		return false;
+	}
+	for (int line = 1; line < tileMaze.rows; line++) {
+		const std::uint64_t* source = tileMaze.horizontalWalls.data () + (size_t) line * tileMaze.horizontalWordsPerLine;
+		std::uint64_t* target = horizontalWalls.data () + (size_t) (begRow + line) * horizontalWordsPerLine + begCol / WallWordBits;
+		std::copy (source, source + tileMaze.horizontalWordsPerLine, target);
+	}
+	for (int line = 1; line < tileMaze.cols; line++) {
+		const std::uint64_t* source = tileMaze.verticalWalls.data () + (size_t) line * tileMaze.verticalWordsPerLine;
+		std::uint64_t* target = verticalWalls.data () + (size_t) (begCol + line) * verticalWordsPerLine + begRow / WallWordBits;
+		std::copy (source, source + tileMaze.verticalWordsPerLine, target);
+	}
+	return true;
+}
+
+int Maze::GetRowCount () const
+{
+	return rows;
+}
+
+int Maze::GetColCount () const
+{
+	return cols;
+}
+
+int Maze::GetCellCount () const
+{
+	return rows * cols;
+}
+
+int Maze::GetWallSlotCount () const
+{
+	return GetHorizontalSlotCount () + rows * (cols + 1);
+}
+
+CellId Maze::GetCellId (int row, int col) const
+{
+	if (row < 0 || row >= rows) {
+		return InvalidCellId;
+	}
+	if (col < 0 || col >= cols) {
+		return InvalidCellId;
+	}
+	return (row * cols + col);
+}
+
+CellId Maze::GetNeighbourCellId (CellId cellId, Direction dir) const
+{
+	int row = cellId / cols;
+	int col = cellId % cols;
+	switch (dir) {
+	case Direction::Left:
+		return GetCellId (row, col - 1);
+	case Direction::Right:
+		return GetCellId (row, col + 1);
+	case Direction::Top:
+		return GetCellId (row - 1, col);
+	case Direction::Bottom:
+		return GetCellId (row + 1, col);
+	default:
+		return InvalidCellId;
+	}
+}
+
+WallId Maze::GetWallId (int row, int col, Direction dir) const
+{
+	if (GetCellId (row, col) == InvalidCellId) {
+		return InvalidWallId;
+	}
+	bool hasWall = false;
+	switch (dir) {
+	case Direction::Top:
+		hasWall = TestBit (horizontalWalls, horizontalWordsPerLine, row, col);
+		break;
+	case Direction::Bottom:
+		hasWall = TestBit (horizontalWalls, horizontalWordsPerLine, row + 1, col);
+		break;
+	case Direction::Left:
+		hasWall = TestBit (verticalWalls, verticalWordsPerLine, col, row);
+		break;
+	case Direction::Right:
+		hasWall = TestBit (verticalWalls, verticalWordsPerLine, col + 1, row);
+		break;
+	default:
+		break;
+	}
+	return (hasWall ? ComputeWallId (row, col, dir) : InvalidWallId);
+}
+
+WallId Maze::ComputeWallId (int row, int col, Direction dir) const
+{
+	if (GetCellId (row, col) == InvalidCellId) {
+		return InvalidWallId;
+	}
+	WallId horizontalCount = GetHorizontalSlotCount ();
+	switch (dir) {
+	case Direction::Top:
+		return row * cols + col;
+	case Direction::Bottom:
+		return (row + 1) * cols + col;
+	case Direction::Left:
+		return horizontalCount + col * rows + row;
+	case Direction::Right:
+		return horizontalCount + (col + 1) * rows + row;
+	default:
+		return InvalidWallId;
+	}
+}
+
+bool Maze::HasWall (WallId wallId) const
+{
+	if (wallId < 0 || wallId >= GetWallSlotCount ()) {
+		return false;
+	}
+	WallId horizontalCount = GetHorizontalSlotCount ();
+	if (wallId < horizontalCount) {
+		return TestBit (horizontalWalls, horizontalWordsPerLine, wallId / cols, wallId % cols);
+	}
+	wallId -= horizontalCount;
+	return TestBit (verticalWalls, verticalWordsPerLine, wallId / rows, wallId % rows);
+}
+
+Cell Maze::GetCell (CellId cellId) const
+{
+	Cell cell;
+	int row = cellId / cols;
+	int col = cellId % cols;
+	static const Direction directions[] = { Direction::Left, Direction::Right, Direction::Top, Direction::Bottom };
+	for (Direction dir : directions) {
+		WallId wallId = GetWallId (row, col, dir);
+		if (wallId != InvalidWallId) {
+			cell.AddWall (dir, wallId);
+		}
+	}
+	return cell;
+}
+
+Wall Maze::GetWall (WallId wallId) const
+{
+	WallId horizontalCount = GetHorizontalSlotCount ();
+	if (wallId < 0 || wallId >= GetWallSlotCount ()) {
+		return Wall ();
+	}
+	if (wallId < horizontalCount) {
+		int row = wallId / cols;
+		int col = wallId % cols;
+		if (row == rows) {
+			return Wall (GetCellId (row - 1, col), InvalidCellId);
+		}
+		return Wall (GetCellId (row, col), GetCellId (row - 1, col));
+	}
+	int col = (wallId - horizontalCount) / rows;
+	int row = (wallId - horizontalCount) % rows;
+	if (col == cols) {
+		return Wall (GetCellId (row, col - 1), InvalidCellId);
+	}
+	return Wall (GetCellId (row, col), GetCellId (row, col - 1));
+}
+
+WallId Maze::AddWall (int row, int col, Direction dir)
+{
+	WallId wallId = ComputeWallId (row, col, dir);
+	if (wallId == InvalidWallId || HasWall (wallId)) {
+		return InvalidWallId;
+	}
+	SetWall (wallId, true);
+	return wallId;
+}
+
+void Maze::RemoveWall (WallId wallId)
+{
+	SetWall (wallId, false);
+}
+
+WallBitsView Maze::GetWallBits () const
+{
+	WallBitsView bits;
+	bits.rowCount = rows;
+	bits.colCount = cols;
+	bits.horizontalWordsPerLine = horizontalWordsPerLine;
+	bits.verticalWordsPerLine = verticalWordsPerLine;
+	bits.horizontalBits = horizontalWalls.data ();
+	bits.verticalBits = verticalWalls.data ();
+	return bits;
+}
+
+std::vector<WallGeometry> Maze::GetWallGeometries (double cellSize) const
+{
+	return GetWallGeometries (cellSize, 1);
+}
+
+std::vector<WallGeometry> Maze::GetWallGeometries (double cellSize, int threadCount) const
+{
+	return ExtractWallGeometries (GetWallBits (), cellSize, threadCount);
+}
+
+int Maze::GetHorizontalSlotCount () const
+{
+	return (rows + 1) * cols;
+}
+
+void Maze::SetWall (WallId wallId, bool hasWall)
+{
+	if (wallId < 0 || wallId >= GetWallSlotCount ()) {
+		return;
+	}
+	WallId horizontalCount = GetHorizontalSlotCount ();
+	if (wallId < horizontalCount) {
+		SetBit (horizontalWalls, horizontalWordsPerLine, wallId / cols, wallId % cols, hasWall);
+	} else {
+		wallId -= horizontalCount;
+		SetBit (verticalWalls, verticalWordsPerLine, wallId / rows, wallId % rows, hasWall);
+	}
+}
+
+MazeGenerator::MazeGenerator (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType) :
+	maze (),
+	rowCount (rowCount),
+	colCount (colCount),
+	cellMask (nullptr),
+	ownRandomEngine (seed),
+	randomEngine (ownRandomEngine),
+	algorithm (CreateMazeAlgorithm (algorithmType).release ())
+{
+
+}
+
+MazeGenerator::MazeGenerator (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType, MemoryArena& arena) :
+	maze (arena),
+	rowCount (rowCount),
+	colCount (colCount),
+	cellMask (nullptr),
+	ownRandomEngine (seed),
+	randomEngine (ownRandomEngine),
+	algorithm (CreateMazeAlgorithm (algorithmType, arena))
+{
+
+}
+
+MazeGenerator::MazeGenerator (int rowCount, int colCount, RandomEngine& randomEngine, MazeAlgorithmType algorithmType) :
+	maze (),
+	rowCount (rowCount),
+	colCount (colCount),
+	cellMask (nullptr),
+	ownRandomEngine (),
+	randomEngine (randomEngine),
+	algorithm (CreateMazeAlgorithm (algorithmType).release ())
+{
+
+}
+
+MazeGenerator::MazeGenerator (const CellMask& cellMask, std::uint64_t seed, MazeAlgorithmType algorithmType) :
+	maze (),
+	rowCount (cellMask.GetRowCount ()),
+	colCount (cellMask.GetColCount ()),
+	cellMask (&cellMask),
+	ownRandomEngine (seed),
+	randomEngine (ownRandomEngine),
+	algorithm (CreateMazeAlgorithm (algorithmType).release ())
+{
+
+}
+
+MazeGenerator::MazeGenerator (const MazeBiasField& biasField, std::uint64_t seed) :
+	maze (),
+	rowCount (biasField.GetRowCount ()),
+	colCount (biasField.GetColCount ()),
+	cellMask (nullptr),
+	ownRandomEngine (seed),
+	randomEngine (ownRandomEngine),
+	algorithm (new WeightedPrimAlgorithm (biasField))
+{
+
+}
+
+MazeGenerator::~MazeGenerator ()
+{
+
+}
+
+void MazeGenerator::SetCancellationToken (const CancellationToken* newCancellationToken)
+{
+	if (algorithm != nullptr) {
+		algorithm->SetCancellationToken (newCancellationToken);
+	}
+}
+
+bool MazeGenerator::Generate ()
+{
+	if (algorithm == nullptr) {
+		return false;
+	}
+	if (cellMask != nullptr) {
+		return GenerateMaze (maze, *cellMask, *algorithm, randomEngine);
+	}
+	return GenerateMaze (maze, rowCount, colCount, *algorithm, randomEngine);
+}
+
+bool GenerateMaze (Maze& maze, int rowCount, int colCount, MazeAlgorithm& algorithm, RandomEngine& randomEngine)
+{
+	if (rowCount <= 0 || colCount <= 0) {
+		return false;
+	}
+
+	maze.Reset (rowCount, colCount);
+	algorithm.Generate (maze, randomEngine);
+	if (algorithm.IsCancelled ()) {
+		return false;
+	}
+
+	WallId entrance = maze.GetWallId (0, 0, Direction::Top);
+	WallId exit = maze.GetWallId (rowCount - 1, colCount - 1, Direction::Bottom);
+	maze.RemoveWall (entrance);
+	maze.RemoveWall (exit);
+
+	return true;
+}
+
+bool GenerateMaze (Maze& maze, const CellMask& cellMask, MazeAlgorithm& algorithm, RandomEngine& randomEngine)
+{
+	if (cellMask.IsFull ()) {
+		return GenerateMaze (maze, cellMask.GetRowCount (), cellMask.GetColCount (), algorithm, randomEngine);
+	}
+	if (!IsCellMaskConnected (cellMask)) {
+		return false;
+	}
+
+	maze.Reset (cellMask);
+	if (!algorithm.GenerateMasked (maze, cellMask, randomEngine) || algorithm.IsCancelled ()) {
+		return false;
+	}
+
+	int cols = cellMask.GetColCount ();
+	CellId entranceCellId = cellMask.FindFirstActiveCell ();
+	CellId exitCellId = cellMask.FindLastActiveCell ();
+	maze.RemoveWall (maze.ComputeWallId (entranceCellId / cols, entranceCellId % cols, Direction::Top));
+	maze.RemoveWall (maze.ComputeWallId (exitCellId / cols, exitCellId % cols, Direction::Bottom));
+
+	return true;
+}
+
+const Maze& MazeGenerator::GetMaze () const
+{
+	return maze;
+}
+
+}
@@ -0,0 +1,203 @@
+#ifndef MAZEGENERATOR_HPP
+#define MAZEGENERATOR_HPP
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <cstdint>
+
+#include "RandomEngine.hpp"
+#include "MemoryArena.hpp"
+
+namespace MG
+{
+
+using CellId = int;
+using WallId = int;
+extern const CellId InvalidCellId;
+extern const WallId InvalidWallId;
+
+enum class Direction
+{
+	Left,
+	Right,
+	Top,
+	Bottom,
+	Up,
+	Down,
+	Invalid
+};
+
+enum class MazeAlgorithmType
+{
+	Prim,
+	Kruskal,
+	RecursiveBacktracker,
+	Wilson,
+	Eller,
+	BinaryTree,
+	Sidewinder
+};
+
+class CancellationToken
+{
+public:
+	CancellationToken ();
+
+	void	Cancel ();
+	bool	IsCancelled () const;
+
+private:
+	std::atomic<bool>	cancelled;
+};
+
+class MazeAlgorithm;
+class CellMask;
+class MazeBiasField;
+
+class MazeAlgorithmDeleter
+{
+public:
+	MazeAlgorithmDeleter ();
+	explicit MazeAlgorithmDeleter (bool arenaAllocated);
+
+	void	operator() (MazeAlgorithm* algorithm) const;
+
+private:
+	bool	arenaAllocated;
+};
+
+using MazeAlgorithmPtr = std::unique_ptr<MazeAlgorithm, MazeAlgorithmDeleter>;
+
+class Cell
+{
+public:
+	Cell ();
+
+	bool	HasWall (Direction dir) const;
+	WallId	GetWall (Direction dir) const;
+	void	EnumerateWalls (const std::function<void (WallId)>& processor) const;
+	void	AddWall (Direction dir, WallId wallId);
+	void	RemoveWall (WallId wallId);
+
+private:
+	WallId	walls[4];
+};
+
+class Wall
+{
+public:
+	Wall ();
+	Wall (CellId cellId1, CellId cellId2);
+
+	CellId	GetCellId1 () const;
+	CellId	GetCellId2 () const;
+	CellId	GetOtherCellId (CellId cellId) const;
+
+private:
+	CellId	cellId1;
+	CellId	cellId2;
+};
+
+class WallGeometry
+{
+public:
+	WallGeometry ();
+	WallGeometry (double begX, double begY, double endX, double endY);
+
+	double begX;
+	double begY;
+	double endX;
+	double endY;
+};
+
+static const int WallWordBits = 64;
+
+class WallBitsView
+{
+public:
+	WallBitsView ();
+
+	int						rowCount;
+	int						colCount;
+	int						horizontalWordsPerLine;
+	int						verticalWordsPerLine;
+	const std::uint64_t*	horizontalBits;
+	const std::uint64_t*	verticalBits;
+};
+
+class Maze
+{
+public:
+	Maze ();
+	explicit Maze (MemoryArena& arena);
+	Maze (int rowCount, int colCount);
+
+	void						Reset (int rowCount, int colCount);
+	void						Reset (const CellMask& cellMask);
+	bool						SetWallBits (const WallBitsView& bits);
+	bool						CopyTileWalls (const Maze& tileMaze, int begRow, int begCol);
+
+	int							GetRowCount () const;
+	int							GetColCount () const;
+	int							GetCellCount () const;
+	int							GetWallSlotCount () const;
+
+	CellId						GetCellId (int row, int col) const;
+	CellId						GetNeighbourCellId (CellId cellId, Direction dir) const;
+	WallId						GetWallId (int row, int col, Direction dir) const;
+	WallId						ComputeWallId (int row, int col, Direction dir) const;
+	bool						HasWall (WallId wallId) const;
+
+	Cell						GetCell (CellId cellId) const;
+	Wall						GetWall (WallId wallId) const;
+
+	WallId						AddWall (int row, int col, Direction dir);
+	void						RemoveWall (WallId wallId);
+
+	WallBitsView				GetWallBits () const;
+	std::vector<WallGeometry>	GetWallGeometries (double cellSize) const;
+	std::vector<WallGeometry>	GetWallGeometries (double cellSize, int threadCount) const;
+
+private:
+	int							GetHorizontalSlotCount () const;
+	void						SetWall (WallId wallId, bool hasWall);
+
+	int							rows;
+	int							cols;
+	int							horizontalWordsPerLine;
+	int							verticalWordsPerLine;
+	ArenaVector<std::uint64_t>	horizontalWalls;
+	ArenaVector<std::uint64_t>	verticalWalls;
+};
+
+class MazeGenerator
+{
+public:
+	MazeGenerator (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType = MazeAlgorithmType::Prim);
+	MazeGenerator (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType, MemoryArena& arena);
+	MazeGenerator (int rowCount, int colCount, RandomEngine& randomEngine, MazeAlgorithmType algorithmType = MazeAlgorithmType::Prim);
+	MazeGenerator (const CellMask& cellMask, std::uint64_t seed, MazeAlgorithmType algorithmType = MazeAlgorithmType::Prim);
+	MazeGenerator (const MazeBiasField& biasField, std::uint64_t seed);
+	MazeGenerator (const MazeGenerator&) = delete;
+	MazeGenerator& operator= (const MazeGenerator&) = delete;
+	~MazeGenerator ();
+
+	void			SetCancellationToken (const CancellationToken* newCancellationToken);
+	bool			Generate ();
+	const Maze&		GetMaze () const;
+
+private:
+	Maze				maze;
+	int					rowCount;
+	int					colCount;
+	const CellMask*		cellMask;
+	Xoshiro256Engine	ownRandomEngine;
+	RandomEngine&		randomEngine;
+	MazeAlgorithmPtr	algorithm;
+};
+
+}
+
+#endif
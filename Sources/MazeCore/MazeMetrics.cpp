@@ -0,0 +1,192 @@
+#include "MazeMetrics.hpp"
+#include "MazeSolver.hpp"
+#include "WallBits.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+
+namespace MG
+{
+
+static const int PassageDegrees[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+static const int MeasuredCorridorShift = 4;
+
+static size_t MeasureCorridor (std::vector<std::uint8_t>& passages, const CellId offsets[4], CellId cellId, int dirIndex)
+{
+	size_t length = 1;
+	CellId current = cellId + offsets[dirIndex];
+	int fromDirIndex = dirIndex ^ 1;
+	while (true) {
+		std::uint8_t cellPassages = passages[current] & PassageMask;
+		if (PassageDegrees[cellPassages] != 2) {
+			break;
+		}
+		int nextDirIndex = CountTrailingZeros (cellPassages & (std::uint8_t) ~(1 << fromDirIndex));
+		current += offsets[nextDirIndex];
+		fromDirIndex = nextDirIndex ^ 1;
+		length += 1;
+	}
+	passages[current] |= (std::uint8_t) (1 << (fromDirIndex + MeasuredCorridorShift));
+	return length;
+}
+
+static bool IsBetterMetricValue (double value, double bestValue, bool maximize)
+{
+	return maximize ? value > bestValue : value < bestValue;
+}
+
+MazeMetrics::MazeMetrics () :
+	cellCount (0),
+	deadEndCount (0),
+	corridorCellCount (0),
+	junctionCellCount (0),
+	branchingFactor (0.0),
+	riverFactor (0.0),
+	solutionLength (0),
+	longestCorridor (0)
+{
+
+}
+
+MazeSeedSearchResult::MazeSeedSearchResult () :
+	seed (0),
+	metrics (),
+	candidateCount (0)
+{
+
+}
+
+MazeMetrics ComputeMazeMetrics (const WallBitsView& bits)
+{
+	MazeMetrics metrics;
+	std::vector<std::uint8_t> passages;
+	BuildCellPassages (bits, passages);
+	metrics.cellCount = passages.size ();
+	if (metrics.cellCount == 0) {
+		return metrics;
+	}
+
+	CellId offsets[4] = { -1, 1, -bits.colCount, bits.colCount };
+	size_t extraBranchCount = 0;
+	for (CellId cellId = 0; cellId < (CellId) passages.size (); cellId++) {
+		std::uint8_t cellPassages = passages[cellId] & PassageMask;
+		int degree = PassageDegrees[cellPassages];
+		if (degree == 2) {
+			metrics.corridorCellCount += 1;
+			continue;
+		}
+		if (degree == 1) {
+			metrics.deadEndCount += 1;
+		} else if (degree > 2) {
+			metrics.junctionCellCount += 1;
+			extraBranchCount += degree - 2;
+		}
+		cellPassages &= (std::uint8_t) ~(passages[cellId] >> MeasuredCorridorShift);
+		while (cellPassages != 0) {
+			size_t corridorLength = MeasureCorridor (passages, offsets, cellId, CountTrailingZeros (cellPassages));
+			metrics.longestCorridor = std::max (metrics.longestCorridor, corridorLength);
+			cellPassages &= cellPassages - 1;
+		}
+		passages[cellId] &= PassageMask;
+	}
+	metrics.branchingFactor = (double) extraBranchCount / metrics.cellCount;
+	metrics.riverFactor = (double) metrics.corridorCellCount / metrics.cellCount;
+
+	MazeSolution solution = SolveCellPassages (passages, bits.colCount, 0, (CellId) passages.size () - 1, MazeSolverType::BreadthFirst);
+	metrics.solutionLength = solution.cells.size ();
+	return metrics;
+}
+
+MazeMetrics ComputeMazeMetrics (const Maze& maze)
+{
+	return ComputeMazeMetrics (maze.GetWallBits ());
+}
+
+double GetMazeMetricValue (const MazeMetrics& metrics, MazeMetricType metricType)
+{
+	switch (metricType) {
+	case MazeMetricType::DeadEndCount:
+		return (double) metrics.deadEndCount;
+	case MazeMetricType::BranchingFactor:
+		return metrics.branchingFactor;
+	case MazeMetricType::RiverFactor:
+		return metrics.riverFactor;
+	case MazeMetricType::SolutionLength:
+		return (double) metrics.solutionLength;
+	case MazeMetricType::LongestCorridor:
+		return (double) metrics.longestCorridor;
+	}
+	return 0.0;
+}
+
+MazeSeedSearchResult FindBestMazeSeed (int rowCount, int colCount, MazeAlgorithmType algorithmType, std::uint64_t firstSeed, size_t candidateCount,
+	MazeMetricType metricType, bool maximize, int threadCount)
+{
+	std::vector<MazeMetrics> candidateMetrics (candidateCount);
+	std::vector<char> generated (candidateCount, 0);
+	ParallelFor ((int) candidateCount, threadCount, [&] (int candidateIndex, int) {
+		MazeGenerator generator (rowCount, colCount, firstSeed + candidateIndex, algorithmType);
+		if (generator.Generate ()) {
+			candidateMetrics[candidateIndex] = ComputeMazeMetrics (generator.GetMaze ());
+			generated[candidateIndex] = 1;
+		}
+	});
+
+	MazeSeedSearchResult result;
+	bool found = false;
+	for (size_t candidateIndex = 0; candidateIndex < candidateCount; candidateIndex++) {
+		if (generated[candidateIndex] == 0) {
+			continue;
+		}
+		double value = GetMazeMetricValue (candidateMetrics[candidateIndex], metricType);
+		if (!found || IsBetterMetricValue (value, GetMazeMetricValue (result.metrics, metricType), maximize)) {
+			result.seed = firstSeed + candidateIndex;
+			result.metrics = candidateMetrics[candidateIndex];
+			found = true;
+		}
+		result.candidateCount += 1;
+	}
+	return result;
+}
+
+const char* GetMazeMetricName (MazeMetricType metricType)
+{
+	switch (metricType) {
+	case MazeMetricType::DeadEndCount:
+		return "deadends";
+	case MazeMetricType::BranchingFactor:
+		return "branching";
+	case MazeMetricType::RiverFactor:
+		return "river";
+	case MazeMetricType::SolutionLength:
+		return "solution";
+	case MazeMetricType::LongestCorridor:
+		return "corridor";
+	}
+	return "";
+}
+
+bool FindMazeMetricType (const std::string& name, MazeMetricType& metricType)
+{
+	for (MazeMetricType candidate : GetAllMazeMetricTypes ()) {
+		if (name == GetMazeMetricName (candidate)) {
+			metricType = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+const std::vector<MazeMetricType>& GetAllMazeMetricTypes ()
+{
+	static const std::vector<MazeMetricType> metricTypes = {
+		MazeMetricType::DeadEndCount,
+		MazeMetricType::BranchingFactor,
+		MazeMetricType::RiverFactor,
+		MazeMetricType::SolutionLength,
+		MazeMetricType::LongestCorridor
+	};
+	return metricTypes;
+}
+
+}
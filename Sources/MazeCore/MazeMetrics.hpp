@@ -0,0 +1,58 @@
+#ifndef MAZEMETRICS_HPP
+#define MAZEMETRICS_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <string>
+
+namespace MG
+{
+
+enum class MazeMetricType
+{
+	DeadEndCount,
+	BranchingFactor,
+	RiverFactor,
+	SolutionLength,
+	LongestCorridor
+};
+
+class MazeMetrics
+{
+public:
+	MazeMetrics ();
+
+	size_t	cellCount;
+	size_t	deadEndCount;
+	size_t	corridorCellCount;
+	size_t	junctionCellCount;
+	double	branchingFactor;
+	double	riverFactor;
+	size_t	solutionLength;
+	size_t	longestCorridor;
+};
+
+class MazeSeedSearchResult
+{
+public:
+	MazeSeedSearchResult ();
+
+	std::uint64_t	seed;
+	MazeMetrics		metrics;
+	size_t			candidateCount;
+};
+
+MazeMetrics				ComputeMazeMetrics (const WallBitsView& bits);
+MazeMetrics				ComputeMazeMetrics (const Maze& maze);
+double					GetMazeMetricValue (const MazeMetrics& metrics, MazeMetricType metricType);
+
+MazeSeedSearchResult	FindBestMazeSeed (int rowCount, int colCount, MazeAlgorithmType algorithmType, std::uint64_t firstSeed, size_t candidateCount,
+							MazeMetricType metricType, bool maximize, int threadCount);
+
+const char*				GetMazeMetricName (MazeMetricType metricType);
+bool					FindMazeMetricType (const std::string& name, MazeMetricType& metricType);
+const std::vector<MazeMetricType>&	GetAllMazeMetricTypes ();
+
+}
+
+#endif
@@ -0,0 +1,470 @@
+#include "MazeRegion.hpp"
+#include "MazeSolver.hpp"
+#include "WallBits.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace MG
+{
+
+static const Direction RegionDirections[] = { Direction::Left, Direction::Right, Direction::Top, Direction::Bottom };
+static const int RegionRowOffsets[] = { 0, 0, -1, 1 };
+static const int RegionColOffsets[] = { -1, 1, 0, 0 };
+static const int RightDirIndex = 1;
+static const int BottomDirIndex = 3;
+
+static bool TestLineBit (const std::uint64_t* line, int position)
+{
+	return ((line[position / WallWordBits] >> (position % WallWordBits)) & 1) != 0;
+}
+
+static bool HasCellWall (const WallBitsView& bits, int row, int col, int dirIndex)
+{
+	if (dirIndex == 0 || dirIndex == RightDirIndex) {
+		return TestLineBit (GetVerticalLine (bits, col + dirIndex), row);
+	}
+	return TestLineBit (GetHorizontalLine (bits, row + (dirIndex == BottomDirIndex ? 1 : 0)), col);
+}
+
+class RegionRegenerator
+{
+public:
+	RegionRegenerator (Maze& maze, const MazeRegion& region);
+
+	void	Run (RandomEngine& randomEngine);
+	void	CollectChangedWalls (std::vector<WallId>& changedWallIds) const;
+
+private:
+	WallId	GetWallId (int cellIndex, int dirIndex) const;
+	bool	IsAnchor (int cellIndex) const;
+	int		FindSet (int cellIndex);
+
+	void	CollectPassages ();
+	void	FindComponents ();
+	void	FindSkeletons ();
+	void	ReconnectCells (RandomEngine& randomEngine);
+	void	ReattachDetachedCells ();
+
+	Maze&						maze;
+	const MazeRegion&			region;
+	WallBitsView				bits;
+	int							cellCount;
+	int							offsets[4];
+	std::vector<bool>			inRegion;
+	std::vector<std::uint8_t>	innerNeighbours;
+	std::vector<std::uint8_t>	outerNeighbours;
+	std::vector<std::uint8_t>	passages;
+	std::vector<std::uint8_t>	boundaryPassages;
+	std::vector<std::uint8_t>	closedPassages;
+	std::vector<int>			componentIds;
+	std::vector<int>			componentBoundaryCounts;
+	std::vector<bool>			skeleton;
+	std::vector<int>			parents;
+	std::vector<bool>			anchored;
+};
+
+RegionRegenerator::RegionRegenerator (Maze& maze, const MazeRegion& region) :
+	maze (maze),
+	region (region),
+	bits (maze.GetWallBits ()),
+	cellCount (region.rowCount * region.colCount),
+	offsets { -1, 1, -region.colCount, region.colCount },
+	inRegion (cellCount, false),
+	innerNeighbours (cellCount, 0),
+	outerNeighbours (cellCount, 0),
+	passages (cellCount, 0),
+	boundaryPassages (cellCount, 0),
+	closedPassages (cellCount, 0),
+	componentIds (cellCount, -1),
+	componentBoundaryCounts (),
+	skeleton (cellCount, false),
+	parents (cellCount, 0),
+	anchored (cellCount, false)
+{
+
+}
+
+void RegionRegenerator::Run (RandomEngine& randomEngine)
+{
+	CollectPassages ();
+	FindComponents ();
+	FindSkeletons ();
+	ReconnectCells (randomEngine);
+	ReattachDetachedCells ();
+}
+
+void RegionRegenerator::CollectChangedWalls (std::vector<WallId>& changedWallIds) const
+{
+	const std::uint8_t forwardDirBits = (std::uint8_t) ((1 << RightDirIndex) | (1 << BottomDirIndex));
+	changedWallIds.clear ();
+	for (int localRow = 0; localRow < region.rowCount; localRow++) {
+		for (int localCol = 0; localCol < region.colCount; localCol++) {
+			int cellIndex = localRow * region.colCount + localCol;
+			int row = region.begRow + localRow;
+			int col = region.begCol + localCol;
+			std::uint8_t oldPassages = passages[cellIndex] | boundaryPassages[cellIndex];
+			std::uint8_t dirBits = outerNeighbours[cellIndex] | (innerNeighbours[cellIndex] & forwardDirBits);
+			while (dirBits != 0) {
+				int dirIndex = CountTrailingZeros (dirBits);
+				dirBits &= dirBits - 1;
+				bool hadWall = (oldPassages & (1 << dirIndex)) == 0;
+				if (HasCellWall (bits, row, col, dirIndex) != hadWall) {
+					changedWallIds.push_back (maze.ComputeWallId (row, col, RegionDirections[dirIndex]));
+				}
+			}
+		}
+	}
+	std::sort (changedWallIds.begin (), changedWallIds.end ());
+}
+
+WallId RegionRegenerator::GetWallId (int cellIndex, int dirIndex) const
+{
+	return maze.ComputeWallId (region.begRow + cellIndex / region.colCount, region.begCol + cellIndex % region.colCount, RegionDirections[dirIndex]);
+}
+
+bool RegionRegenerator::IsAnchor (int cellIndex) const
+{
+	return boundaryPassages[cellIndex] != 0 && componentBoundaryCounts[componentIds[cellIndex]] > 1;
+}
+
+int RegionRegenerator::FindSet (int cellIndex)
+{
+	while (parents[cellIndex] != cellIndex) {
+		parents[cellIndex] = parents[parents[cellIndex]];
+		cellIndex = parents[cellIndex];
+	}
+	return cellIndex;
+}
+
+void RegionRegenerator::CollectPassages ()
+{
+	for (int localRow = 0; localRow < region.rowCount; localRow++) {
+		for (int localCol = 0; localCol < region.colCount; localCol++) {
+			inRegion[localRow * region.colCount + localCol] = region.ContainsCell (region.begRow + localRow, region.begCol + localCol);
+		}
+	}
+	for (int localRow = 0; localRow < region.rowCount; localRow++) {
+		for (int localCol = 0; localCol < region.colCount; localCol++) {
+			int cellIndex = localRow * region.colCount + localCol;
+			if (!inRegion[cellIndex]) {
+				continue;
+			}
+			int row = region.begRow + localRow;
+			int col = region.begCol + localCol;
+			for (int dirIndex = 0; dirIndex < 4; dirIndex++) {
+				int neighbourRow = row + RegionRowOffsets[dirIndex];
+				int neighbourCol = col + RegionColOffsets[dirIndex];
+				if (neighbourRow < 0 || neighbourCol < 0 || neighbourRow >= bits.rowCount || neighbourCol >= bits.colCount) {
+					continue;
+				}
+				int neighbourLocalRow = localRow + RegionRowOffsets[dirIndex];
+				int neighbourLocalCol = localCol + RegionColOffsets[dirIndex];
+				bool inner = (neighbourLocalRow >= 0 && neighbourLocalCol >= 0 && neighbourLocalRow < region.rowCount && neighbourLocalCol < region.colCount &&
+					inRegion[cellIndex + offsets[dirIndex]]);
+				std::uint8_t dirBit = (std::uint8_t) (1 << dirIndex);
+				bool hasWall = HasCellWall (bits, row, col, dirIndex);
+				if (inner) {
+					innerNeighbours[cellIndex] |= dirBit;
+					passages[cellIndex] |= (hasWall ? 0 : dirBit);
+				} else {
+					outerNeighbours[cellIndex] |= dirBit;
+					boundaryPassages[cellIndex] |= (hasWall ? 0 : dirBit);
+				}
+			}
+		}
+	}
+}
+
+void RegionRegenerator::FindComponents ()
+{
+	std::vector<int> stack;
+	for (int firstCellIndex = 0; firstCellIndex < cellCount; firstCellIndex++) {
+		if (!inRegion[firstCellIndex] || componentIds[firstCellIndex] != -1) {
+			continue;
+		}
+		int componentId = (int) componentBoundaryCounts.size ();
+		int boundaryCount = 0;
+		componentIds[firstCellIndex] = componentId;
+		stack.push_back (firstCellIndex);
+		while (!stack.empty ()) {
+			int cellIndex = stack.back ();
+			stack.pop_back ();
+			boundaryCount += CountBits (boundaryPassages[cellIndex]);
+			std::uint8_t cellPassages = passages[cellIndex];
+			while (cellPassages != 0) {
+				int neighbourIndex = cellIndex + offsets[CountTrailingZeros (cellPassages)];
+				cellPassages &= cellPassages - 1;
+				if (componentIds[neighbourIndex] == -1) {
+					componentIds[neighbourIndex] = componentId;
+					stack.push_back (neighbourIndex);
+				}
+			}
+		}
+		componentBoundaryCounts.push_back (boundaryCount);
+	}
+}
+
+void RegionRegenerator::FindSkeletons ()
+{
+	std::vector<int> degrees (cellCount, 0);
+	std::vector<int> prunedCells;
+	for (int cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+		if (!inRegion[cellIndex]) {
+			continue;
+		}
+		if (boundaryPassages[cellIndex] != 0 && !IsAnchor (cellIndex)) {
+			closedPassages[cellIndex] = boundaryPassages[cellIndex];
+		}
+		skeleton[cellIndex] = true;
+		degrees[cellIndex] = CountBits (passages[cellIndex]);
+		if (!IsAnchor (cellIndex) && degrees[cellIndex] <= 1) {
+			prunedCells.push_back (cellIndex);
+		}
+	}
+
+	while (!prunedCells.empty ()) {
+		int cellIndex = prunedCells.back ();
+		prunedCells.pop_back ();
+		if (!skeleton[cellIndex]) {
+			continue;
+		}
+		skeleton[cellIndex] = false;
+		std::uint8_t cellPassages = passages[cellIndex];
+		while (cellPassages != 0) {
+			int neighbourIndex = cellIndex + offsets[CountTrailingZeros (cellPassages)];
+			cellPassages &= cellPassages - 1;
+			if (!skeleton[neighbourIndex]) {
+				continue;
+			}
+			degrees[neighbourIndex] -= 1;
+			if (!IsAnchor (neighbourIndex) && degrees[neighbourIndex] <= 1) {
+				prunedCells.push_back (neighbourIndex);
+			}
+		}
+	}
+}
+
+void RegionRegenerator::ReconnectCells (RandomEngine& randomEngine)
+{
+	std::vector<int> candidates;
+	for (int cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+		parents[cellIndex] = cellIndex;
+		anchored[cellIndex] = skeleton[cellIndex];
+	}
+	for (int localRow = 0; localRow < region.rowCount; localRow++) {
+		for (int localCol = 0; localCol < region.colCount; localCol++) {
+			int cellIndex = localRow * region.colCount + localCol;
+			if (!inRegion[cellIndex]) {
+				continue;
+			}
+			int row = region.begRow + localRow;
+			int col = region.begCol + localCol;
+			for (int dirIndex : { RightDirIndex, BottomDirIndex }) {
+				std::uint8_t dirBit = (std::uint8_t) (1 << dirIndex);
+				if ((innerNeighbours[cellIndex] & dirBit) == 0) {
+					continue;
+				}
+				int neighbourIndex = cellIndex + offsets[dirIndex];
+				bool hasPassage = (passages[cellIndex] & dirBit) != 0;
+				if (hasPassage && skeleton[cellIndex] && skeleton[neighbourIndex]) {
+					parents[FindSet (neighbourIndex)] = FindSet (cellIndex);
+					continue;
+				}
+				if (hasPassage) {
+					maze.AddWall (row, col, RegionDirections[dirIndex]);
+				}
+				candidates.push_back (cellIndex * 4 + dirIndex);
+			}
+			std::uint8_t cellClosedPassages = closedPassages[cellIndex];
+			while (cellClosedPassages != 0) {
+				maze.AddWall (row, col, RegionDirections[CountTrailingZeros (cellClosedPassages)]);
+				cellClosedPassages &= cellClosedPassages - 1;
+			}
+		}
+	}
+
+	for (size_t i = candidates.size (); i > 1; i--) {
+		size_t j = randomEngine.NextBelow ((std::uint32_t) i);
+		std::swap (candidates[i - 1], candidates[j]);
+	}
+
+	for (int candidate : candidates) {
+		int cellIndex = candidate / 4;
+		int dirIndex = candidate % 4;
+		int root1 = FindSet (cellIndex);
+		int root2 = FindSet (cellIndex + offsets[dirIndex]);
+		if (root1 == root2 || (anchored[root1] && anchored[root2])) {
+			continue;
+		}
+		parents[root2] = root1;
+		anchored[root1] = anchored[root1] || anchored[root2];
+		maze.RemoveWall (GetWallId (cellIndex, dirIndex));
+	}
+}
+
+void RegionRegenerator::ReattachDetachedCells ()
+{
+	for (int cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+		if (closedPassages[cellIndex] == 0) {
+			continue;
+		}
+		int root = FindSet (cellIndex);
+		if (anchored[root]) {
+			continue;
+		}
+		maze.RemoveWall (GetWallId (cellIndex, CountTrailingZeros (closedPassages[cellIndex])));
+		anchored[root] = true;
+	}
+}
+
+class WallDiffBuilder
+{
+public:
+	WallDiffBuilder (const Maze& maze, const std::vector<WallId>& changedWallIds, double cellSize);
+
+	void	Build (std::vector<WallGeometry>& removedWalls, std::vector<WallGeometry>& addedWalls);
+
+private:
+	bool	HasWall (int position, bool oldState) const;
+	void	AddWallRun (int position, bool oldState, int& lastRunEnd, std::vector<WallGeometry>& walls) const;
+
+	const std::vector<WallId>&	changedWallIds;
+	WallBitsView				bits;
+	double						cellSize;
+	WallId						horizontalSlotCount;
+	bool						horizontal;
+	int							line;
+	int							lineLength;
+	WallId						lineBegWallId;
+	const std::uint64_t*		lineBits;
+	size_t						lineChangeBeg;
+	size_t						lineChangeEnd;
+};
+
+WallDiffBuilder::WallDiffBuilder (const Maze& maze, const std::vector<WallId>& changedWallIds, double cellSize) :
+	changedWallIds (changedWallIds),
+	bits (maze.GetWallBits ()),
+	cellSize (cellSize),
+	horizontalSlotCount ((maze.GetRowCount () + 1) * maze.GetColCount ()),
+	horizontal (true),
+	line (0),
+	lineLength (0),
+	lineBegWallId (0),
+	lineBits (nullptr),
+	lineChangeBeg (0),
+	lineChangeEnd (0)
+{
+
+}
+
+void WallDiffBuilder::Build (std::vector<WallGeometry>& removedWalls, std::vector<WallGeometry>& addedWalls)
+{
+	while (lineChangeEnd < changedWallIds.size ()) {
+		WallId wallId = changedWallIds[lineChangeEnd];
+		horizontal = (wallId < horizontalSlotCount);
+		lineLength = (horizontal ? bits.colCount : bits.rowCount);
+		line = (horizontal ? wallId : wallId - horizontalSlotCount) / lineLength;
+		lineBegWallId = (horizontal ? 0 : horizontalSlotCount) + line * lineLength;
+		lineBits = (horizontal ? GetHorizontalLine (bits, line) : GetVerticalLine (bits, line));
+		lineChangeBeg = lineChangeEnd;
+		while (lineChangeEnd < changedWallIds.size () && changedWallIds[lineChangeEnd] < lineBegWallId + lineLength) {
+			lineChangeEnd += 1;
+		}
+
+		int lastRemovedEnd = 0;
+		int lastAddedEnd = 0;
+		for (size_t changeIndex = lineChangeBeg; changeIndex < lineChangeEnd; changeIndex++) {
+			int position = changedWallIds[changeIndex] - lineBegWallId;
+			for (int probe = std::max (position - 1, 0); probe <= std::min (position + 1, lineLength - 1); probe++) {
+				AddWallRun (probe, true, lastRemovedEnd, removedWalls);
+				AddWallRun (probe, false, lastAddedEnd, addedWalls);
+			}
+		}
+	}
+}
+
+bool WallDiffBuilder::HasWall (int position, bool oldState) const
+{
+	bool hasWall = TestLineBit (lineBits, position);
+	if (oldState && std::binary_search (changedWallIds.begin () + lineChangeBeg, changedWallIds.begin () + lineChangeEnd, lineBegWallId + position)) {
+		return !hasWall;
+	}
+	return hasWall;
+}
+
+void WallDiffBuilder::AddWallRun (int position, bool oldState, int& lastRunEnd, std::vector<WallGeometry>& walls) const
+{
+	if (position < lastRunEnd || !HasWall (position, oldState)) {
+		return;
+	}
+	int beg = position;
+	while (beg > 0 && HasWall (beg - 1, oldState)) {
+		beg -= 1;
+	}
+	int end = position + 1;
+	while (end < lineLength && HasWall (end, oldState)) {
+		end += 1;
+	}
+	lastRunEnd = end;
+	double elevation = line * cellSize;
+	if (horizontal) {
+		walls.push_back (WallGeometry (beg * cellSize, elevation, end * cellSize, elevation));
+	} else {
+		walls.push_back (WallGeometry (elevation, beg * cellSize, elevation, end * cellSize));
+	}
+}
+
+MazeRegion::MazeRegion () :
+	MazeRegion (0, 0, 0, 0)
+{
+
+}
+
+MazeRegion::MazeRegion (int begRow, int begCol, int rowCount, int colCount) :
+	begRow (begRow),
+	begCol (begCol),
+	rowCount (rowCount),
+	colCount (colCount),
+	cellMask ()
+{
+
+}
+
+bool MazeRegion::ContainsCell (int row, int col) const
+{
+	if (row < begRow || col < begCol || row >= begRow + rowCount || col >= begCol + colCount) {
+		return false;
+	}
+	return cellMask.GetRowCount () == 0 || cellMask.IsCellActive (row - begRow, col - begCol);
+}
+
+MazeWallDiff::MazeWallDiff () :
+	changedWallIds (),
+	removedWalls (),
+	addedWalls ()
+{
+
+}
+
+bool RegenerateMazeRegion (Maze& maze, const MazeRegion& region, RandomEngine& randomEngine, double cellSize, MazeWallDiff& diff)
+{
+	diff = MazeWallDiff ();
+	if (region.rowCount <= 0 || region.colCount <= 0 || region.begRow < 0 || region.begCol < 0 ||
+		region.begRow + region.rowCount > maze.GetRowCount () || region.begCol + region.colCount > maze.GetColCount ()) {
+		return false;
+	}
+	if (region.cellMask.GetRowCount () != 0 && (region.cellMask.GetRowCount () != region.rowCount || region.cellMask.GetColCount () != region.colCount)) {
+		return false;
+	}
+
+	RegionRegenerator regenerator (maze, region);
+	regenerator.Run (randomEngine);
+	regenerator.CollectChangedWalls (diff.changedWallIds);
+
+	WallDiffBuilder diffBuilder (maze, diff.changedWallIds, cellSize);
+	diffBuilder.Build (diff.removedWalls, diff.addedWalls);
+	return true;
+}
+
+}
@@ -0,0 +1,39 @@
+#ifndef MAZEREGION_HPP
+#define MAZEREGION_HPP
+
+#include "MazeGenerator.hpp"
+#include "CellMask.hpp"
+
+namespace MG
+{
+
+class MazeRegion
+{
+public:
+	MazeRegion ();
+	MazeRegion (int begRow, int begCol, int rowCount, int colCount);
+
+	bool	ContainsCell (int row, int col) const;
+
+	int					begRow;
+	int					begCol;
+	int					rowCount;
+	int					colCount;
+	CellMask			cellMask;
+};
+
+class MazeWallDiff
+{
+public:
+	MazeWallDiff ();
+
+	std::vector<WallId>			changedWallIds;
+	std::vector<WallGeometry>	removedWalls;
+	std::vector<WallGeometry>	addedWalls;
+};
+
+bool	RegenerateMazeRegion (Maze& maze, const MazeRegion& region, RandomEngine& randomEngine, double cellSize, MazeWallDiff& diff);
+
+}
+
+#endif
@@ -0,0 +1,323 @@
+#include "MazeSolver.hpp"
+#include "WallBits.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+
+namespace MG
+{
+
+static const std::uint8_t CellVisited = 16;
+static const std::uint8_t CellFilled = 128;
+static const int ParentShift = 5;
+static const std::uint8_t ParentMask = 3 << ParentShift;
+
+class AStarNode
+{
+public:
+	AStarNode (std::uint32_t estimate, std::uint32_t cost, CellId cellId);
+
+	std::uint32_t	estimate;
+	std::uint32_t	cost;
+	CellId			cellId;
+};
+
+AStarNode::AStarNode (std::uint32_t estimate, std::uint32_t cost, CellId cellId) :
+	estimate (estimate),
+	cost (cost),
+	cellId (cellId)
+{
+
+}
+
+static bool IsWorseAStarNode (const AStarNode& a, const AStarNode& b)
+{
+	if (a.estimate != b.estimate) {
+		return a.estimate > b.estimate;
+	}
+	return a.cost < b.cost;
+}
+
+static std::uint64_t GetOpenBits (const std::uint64_t* line, int wordIndex, int lineLength)
+{
+	std::uint64_t openBits = ~line[wordIndex];
+	int remainingBits = lineLength - wordIndex * WallWordBits;
+	if (remainingBits < WallWordBits) {
+		openBits &= ((std::uint64_t) 1 << remainingBits) - 1;
+	}
+	return openBits;
+}
+
+static void GetCellOffsets (int colCount, CellId offsets[4])
+{
+	offsets[0] = -1;
+	offsets[1] = 1;
+	offsets[2] = -colCount;
+	offsets[3] = colCount;
+}
+
+static std::uint32_t GetManhattanDistance (CellId cellId, CellId goalCellId, int colCount)
+{
+	return (std::uint32_t) (std::abs (cellId / colCount - goalCellId / colCount) + std::abs (cellId % colCount - goalCellId % colCount));
+}
+
+static std::vector<CellId> TracePath (const std::vector<std::uint8_t>& cells, int colCount, CellId startCellId, CellId goalCellId)
+{
+	CellId offsets[4];
+	GetCellOffsets (colCount, offsets);
+	std::vector<CellId> path;
+	CellId cellId = goalCellId;
+	path.push_back (cellId);
+	while (cellId != startCellId) {
+		cellId += offsets[(cells[cellId] & ParentMask) >> ParentShift];
+		path.push_back (cellId);
+	}
+	std::reverse (path.begin (), path.end ());
+	return path;
+}
+
+static bool SearchBreadthFirst (std::vector<std::uint8_t>& cells, int colCount, CellId startCellId, CellId goalCellId, MazeSolution& solution)
+{
+	CellId offsets[4];
+	GetCellOffsets (colCount, offsets);
+	std::vector<CellId> frontier (1, startCellId);
+	std::vector<CellId> nextFrontier;
+	size_t frontierCapacity = 0;
+	bool found = (startCellId == goalCellId);
+	cells[startCellId] |= CellVisited;
+	solution.visitedCellCount += 1;
+	while (!found && !frontier.empty ()) {
+		for (CellId cellId : frontier) {
+			std::uint8_t passages = cells[cellId] & PassageMask;
+			while (passages != 0) {
+				int dirIndex = CountTrailingZeros (passages);
+				passages &= passages - 1;
+				CellId nextCellId = cellId + offsets[dirIndex];
+				if ((cells[nextCellId] & CellVisited) != 0) {
+					continue;
+				}
+				cells[nextCellId] |= CellVisited | (std::uint8_t) ((dirIndex ^ 1) << ParentShift);
+				nextFrontier.push_back (nextCellId);
+				found = found || (nextCellId == goalCellId);
+			}
+		}
+		solution.visitedCellCount += nextFrontier.size ();
+		frontierCapacity = std::max (frontierCapacity, frontier.capacity () + nextFrontier.capacity ());
+		frontier.swap (nextFrontier);
+		nextFrontier.clear ();
+	}
+	solution.memoryUsage += frontierCapacity * sizeof (CellId);
+	return found;
+}
+
+static bool SearchAStar (std::vector<std::uint8_t>& cells, int colCount, CellId startCellId, CellId goalCellId, MazeSolution& solution)
+{
+	CellId offsets[4];
+	GetCellOffsets (colCount, offsets);
+	std::vector<std::uint32_t> costs (cells.size (), std::numeric_limits<std::uint32_t>::max ());
+	std::vector<AStarNode> openNodes;
+	costs[startCellId] = 0;
+	openNodes.push_back (AStarNode (GetManhattanDistance (startCellId, goalCellId, colCount), 0, startCellId));
+	bool found = false;
+	while (!found && !openNodes.empty ()) {
+		std::pop_heap (openNodes.begin (), openNodes.end (), IsWorseAStarNode);
+		AStarNode node = openNodes.back ();
+		openNodes.pop_back ();
+		if ((cells[node.cellId] & CellVisited) != 0) {
+			continue;
+		}
+		cells[node.cellId] |= CellVisited;
+		solution.visitedCellCount += 1;
+		found = (node.cellId == goalCellId);
+
+		std::uint8_t passages = cells[node.cellId] & PassageMask;
+		while (!found && passages != 0) {
+			int dirIndex = CountTrailingZeros (passages);
+			passages &= passages - 1;
+			CellId nextCellId = node.cellId + offsets[dirIndex];
+			std::uint32_t nextCost = node.cost + 1;
+			if ((cells[nextCellId] & CellVisited) != 0 || nextCost >= costs[nextCellId]) {
+				continue;
+			}
+			costs[nextCellId] = nextCost;
+			cells[nextCellId] = (cells[nextCellId] & ~ParentMask) | (std::uint8_t) ((dirIndex ^ 1) << ParentShift);
+			openNodes.push_back (AStarNode (nextCost + GetManhattanDistance (nextCellId, goalCellId, colCount), nextCost, nextCellId));
+			std::push_heap (openNodes.begin (), openNodes.end (), IsWorseAStarNode);
+		}
+	}
+	solution.memoryUsage += costs.capacity () * sizeof (std::uint32_t) + openNodes.capacity () * sizeof (AStarNode);
+	return found;
+}
+
+static void FillDeadEnds (std::vector<std::uint8_t>& cells, int colCount, CellId startCellId, CellId goalCellId, MazeSolution& solution)
+{
+	CellId offsets[4];
+	GetCellOffsets (colCount, offsets);
+	CellId cellCount = (CellId) cells.size ();
+	for (CellId cellId = 0; cellId < cellCount; cellId++) {
+		CellId current = cellId;
+		while (current != startCellId && current != goalCellId) {
+			std::uint8_t passages = cells[current] & PassageMask;
+			if (passages == 0 || (passages & (passages - 1)) != 0) {
+				break;
+			}
+			int dirIndex = CountTrailingZeros (passages);
+			cells[current] = (cells[current] & ~PassageMask) | CellFilled;
+			solution.visitedCellCount += 1;
+			current += offsets[dirIndex];
+			cells[current] &= (std::uint8_t) ~(1 << (dirIndex ^ 1));
+		}
+	}
+}
+
+static void BuildCellPassageBlock (const WallBitsView& bits, std::uint8_t* passages, int wordIndex)
+{
+	int rowCount = bits.rowCount;
+	int colCount = bits.colCount;
+	int begRow = wordIndex * WallWordBits;
+	int endRow = std::min (begRow + WallWordBits, rowCount);
+	for (int row = begRow; row < endRow; row++) {
+		std::uint8_t* rowPassages = passages + (size_t) row * colCount;
+		for (int lineOffset = 0; lineOffset < 2; lineOffset++) {
+			int line = row + lineOffset;
+			if (line == 0 || line == rowCount) {
+				continue;
+			}
+			std::uint8_t passage = (lineOffset == 0 ? PassageTop : PassageBottom);
+			for (int lineWordIndex = 0; lineWordIndex < bits.horizontalWordsPerLine; lineWordIndex++) {
+				std::uint64_t openBits = GetOpenBits (GetHorizontalLine (bits, line), lineWordIndex, colCount);
+				while (openBits != 0) {
+					rowPassages[lineWordIndex * WallWordBits + CountTrailingZeros (openBits)] |= passage;
+					openBits &= openBits - 1;
+				}
+			}
+		}
+	}
+	for (int col = 1; col < colCount; col++) {
+		std::uint64_t openBits = GetOpenBits (GetVerticalLine (bits, col), wordIndex, rowCount);
+		while (openBits != 0) {
+			int row = begRow + CountTrailingZeros (openBits);
+			openBits &= openBits - 1;
+			std::uint8_t* cellPassages = passages + (size_t) row * colCount + col;
+			cellPassages[0] |= PassageLeft;
+			cellPassages[-1] |= PassageRight;
+		}
+	}
+}
+
+MazeSolution::MazeSolution () :
+	found (false),
+	cells (),
+	visitedCellCount (0),
+	memoryUsage (0)
+{
+
+}
+
+void BuildCellPassages (const WallBitsView& bits, std::vector<std::uint8_t>& passages)
+{
+	BuildCellPassages (bits, passages, 1);
+}
+
+void BuildCellPassages (const WallBitsView& bits, std::vector<std::uint8_t>& passages, int threadCount)
+{
+	passages.assign ((size_t) bits.rowCount * bits.colCount, 0);
+	ParallelFor (bits.verticalWordsPerLine, threadCount, [&] (int wordIndex, int) {
+		BuildCellPassageBlock (bits, passages.data (), wordIndex);
+	});
+}
+
+MazeSolution SolveCellPassages (std::vector<std::uint8_t>& passages, int colCount, CellId startCellId, CellId goalCellId, MazeSolverType solverType)
+{
+	MazeSolution solution;
+	CellId cellCount = (CellId) passages.size ();
+	if (startCellId < 0 || startCellId >= cellCount || goalCellId < 0 || goalCellId >= cellCount) {
+		return solution;
+	}
+
+	switch (solverType) {
+	case MazeSolverType::BreadthFirst:
+		solution.found = SearchBreadthFirst (passages, colCount, startCellId, goalCellId, solution);
+		break;
+	case MazeSolverType::AStar:
+		solution.found = SearchAStar (passages, colCount, startCellId, goalCellId, solution);
+		break;
+	case MazeSolverType::DeadEndFilling:
+		FillDeadEnds (passages, colCount, startCellId, goalCellId, solution);
+		solution.found = SearchBreadthFirst (passages, colCount, startCellId, goalCellId, solution);
+		break;
+	}
+	if (solution.found) {
+		solution.cells = TracePath (passages, colCount, startCellId, goalCellId);
+	}
+	return solution;
+}
+
+MazeSolution SolveMaze (const WallBitsView& bits, CellId startCellId, CellId goalCellId, MazeSolverType solverType)
+{
+	std::vector<std::uint8_t> passages;
+	BuildCellPassages (bits, passages);
+	MazeSolution solution = SolveCellPassages (passages, bits.colCount, startCellId, goalCellId, solverType);
+	solution.memoryUsage += passages.capacity ();
+	return solution;
+}
+
+MazeSolution SolveMaze (const Maze& maze, MazeSolverType solverType)
+{
+	if (maze.GetCellCount () == 0) {
+		return MazeSolution ();
+	}
+	return SolveMaze (maze.GetWallBits (), maze.GetCellId (0, 0), maze.GetCellId (maze.GetRowCount () - 1, maze.GetColCount () - 1), solverType);
+}
+
+std::vector<WallPoint> GetSolutionPolyline (const std::vector<CellId>& cells, int colCount, double cellSize)
+{
+	std::vector<WallPoint> points;
+	for (size_t i = 0; i < cells.size (); i++) {
+		if (i > 0 && i + 1 < cells.size () && cells[i] - cells[i - 1] == cells[i + 1] - cells[i]) {
+			continue;
+		}
+		int row = cells[i] / colCount;
+		int col = cells[i] % colCount;
+		points.push_back (WallPoint ((col + 0.5) * cellSize, (row + 0.5) * cellSize));
+	}
+	return points;
+}
+
+const char* GetMazeSolverName (MazeSolverType solverType)
+{
+	switch (solverType) {
+	case MazeSolverType::BreadthFirst:
+		return "bfs";
+	case MazeSolverType::AStar:
+		return "astar";
+	case MazeSolverType::DeadEndFilling:
+		return "deadend";
+	}
+	return "";
+}
+
+bool FindMazeSolverType (const std::string& name, MazeSolverType& solverType)
+{
+	for (MazeSolverType candidate : GetAllMazeSolverTypes ()) {
+		if (name == GetMazeSolverName (candidate)) {
+			solverType = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+const std::vector<MazeSolverType>& GetAllMazeSolverTypes ()
+{
+	static const std::vector<MazeSolverType> solverTypes = {
+		MazeSolverType::BreadthFirst,
+		MazeSolverType::AStar,
+		MazeSolverType::DeadEndFilling
+	};
+	return solverTypes;
+}
+
+}
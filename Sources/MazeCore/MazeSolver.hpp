@@ -0,0 +1,50 @@
+#ifndef MAZESOLVER_HPP
+#define MAZESOLVER_HPP
+
+#include "MazeGenerator.hpp"
+#include "WallPolylines.hpp"
+
+#include <string>
+
+namespace MG
+{
+
+static const std::uint8_t PassageLeft = 1;
+static const std::uint8_t PassageRight = 2;
+static const std::uint8_t PassageTop = 4;
+static const std::uint8_t PassageBottom = 8;
+static const std::uint8_t PassageMask = 15;
+
+enum class MazeSolverType
+{
+	BreadthFirst,
+	AStar,
+	DeadEndFilling
+};
+
+class MazeSolution
+{
+public:
+	MazeSolution ();
+
+	bool				found;
+	std::vector<CellId>	cells;
+	size_t				visitedCellCount;
+	size_t				memoryUsage;
+};
+
+void					BuildCellPassages (const WallBitsView& bits, std::vector<std::uint8_t>& passages);
+void					BuildCellPassages (const WallBitsView& bits, std::vector<std::uint8_t>& passages, int threadCount);
+
+MazeSolution			SolveCellPassages (std::vector<std::uint8_t>& passages, int colCount, CellId startCellId, CellId goalCellId, MazeSolverType solverType);
+MazeSolution			SolveMaze (const WallBitsView& bits, CellId startCellId, CellId goalCellId, MazeSolverType solverType);
+MazeSolution			SolveMaze (const Maze& maze, MazeSolverType solverType);
+std::vector<WallPoint>	GetSolutionPolyline (const std::vector<CellId>& cells, int colCount, double cellSize);
+
+const char*				GetMazeSolverName (MazeSolverType solverType);
+bool					FindMazeSolverType (const std::string& name, MazeSolverType& solverType);
+const std::vector<MazeSolverType>&	GetAllMazeSolverTypes ();
+
+}
+
+#endif
@@ -0,0 +1,93 @@
+#include "MazeStreaming.hpp"
+#include "WallCollector.hpp"
+
+namespace MG
+{
+
+StreamingMazeGenerator::StreamingMazeGenerator (int rowCount, int colCount, std::uint64_t seed) :
+	rowCount (rowCount),
+	colCount (colCount),
+	ownRandomEngine (seed),
+	randomEngine (ownRandomEngine),
+	rowGenerator ()
+{
+
+}
+
+StreamingMazeGenerator::StreamingMazeGenerator (int rowCount, int colCount, RandomEngine& randomEngine) :
+	rowCount (rowCount),
+	colCount (colCount),
+	ownRandomEngine (),
+	randomEngine (randomEngine),
+	rowGenerator ()
+{
+
+}
+
+bool StreamingMazeGenerator::Generate (double cellSize, const WallRowSink& sink)
+{
+	if (rowCount <= 0 || colCount <= 0) {
+		return false;
+	}
+
+	std::vector<WallGeometry> finishedWalls;
+	std::vector<WallCollector> verticalCollectors;
+	for (int col = 0; col <= colCount; col++) {
+		verticalCollectors.push_back (WallCollector (finishedWalls, WallCollector::Direction::Vertical, col * cellSize));
+	}
+
+	ArenaVector<unsigned char> rightPassages;
+	ArenaVector<unsigned char> bottomPassages (colCount, 0);
+	rowGenerator.Start (colCount);
+
+	for (int row = 0; row < rowCount; row++) {
+		double top = row * cellSize;
+		double bottom = (row + 1) * cellSize;
+
+		WallCollector topCollector (finishedWalls, WallCollector::Direction::Horizontal, top);
+		for (int col = 0; col < colCount; col++) {
+			bool entrance = (row == 0 && col == 0);
+			bool hasWall = (row == 0 ? !entrance : bottomPassages[col] == 0);
+			if (hasWall) {
+				topCollector.AddWall (col * cellSize, (col + 1) * cellSize);
+			}
+		}
+		topCollector.Flush ();
+
+		rowGenerator.GenerateRow (row == rowCount - 1, randomEngine, rightPassages, bottomPassages);
+
+		for (int col = 0; col <= colCount; col++) {
+			bool hasWall = (col == 0 || col == colCount || rightPassages[col - 1] == 0);
+			if (hasWall) {
+				verticalCollectors[col].AddWall (top, bottom);
+			} else {
+				verticalCollectors[col].Flush ();
+			}
+		}
+
+		if (row == rowCount - 1) {
+			WallCollector bottomCollector (finishedWalls, WallCollector::Direction::Horizontal, bottom);
+			for (int col = 0; col < colCount; col++) {
+				bool exit = (col == colCount - 1);
+				if (!exit) {
+					bottomCollector.AddWall (col * cellSize, (col + 1) * cellSize);
+				}
+			}
+			bottomCollector.Flush ();
+			for (WallCollector& collector : verticalCollectors) {
+				collector.Flush ();
+			}
+		}
+
+		if (!finishedWalls.empty ()) {
+			if (!sink (row, finishedWalls)) {
+				return false;
+			}
+			finishedWalls.clear ();
+		}
+	}
+
+	return true;
+}
+
+}
@@ -0,0 +1,30 @@
+#ifndef MAZESTREAMING_HPP
+#define MAZESTREAMING_HPP
+
+#include "MazeGenerator.hpp"
+#include "MazeAlgorithms.hpp"
+
+namespace MG
+{
+
+using WallRowSink = std::function<bool (int row, const std::vector<WallGeometry>& finishedWalls)>;
+
+class StreamingMazeGenerator
+{
+public:
+	StreamingMazeGenerator (int rowCount, int colCount, std::uint64_t seed);
+	StreamingMazeGenerator (int rowCount, int colCount, RandomEngine& randomEngine);
+
+	bool	Generate (double cellSize, const WallRowSink& sink);
+
+private:
+	int							rowCount;
+	int							colCount;
+	Xoshiro256Engine			ownRandomEngine;
+	RandomEngine&				randomEngine;
+	EllerRowGenerator			rowGenerator;
+};
+
+}
+
+#endif
@@ -0,0 +1,43 @@
+#include "MazeTopologies.hpp"
+
+namespace MG
+{
+
+const char* GetMazeTopologyName (MazeTopologyType topologyType)
+{
+	switch (topologyType) {
+	case MazeTopologyType::Square:
+		return SquareTopology::GetName ();
+	case MazeTopologyType::Hex:
+		return HexTopology::GetName ();
+	case MazeTopologyType::Triangle:
+		return TriangleTopology::GetName ();
+	case MazeTopologyType::Polar:
+		return PolarTopology::GetName ();
+	}
+	return "";
+}
+
+bool FindMazeTopologyType (const std::string& name, MazeTopologyType& topologyType)
+{
+	for (MazeTopologyType candidate : GetAllMazeTopologyTypes ()) {
+		if (name == GetMazeTopologyName (candidate)) {
+			topologyType = candidate;
+			return true;
+		}
+	}
+	return false;
+}
+
+const std::vector<MazeTopologyType>& GetAllMazeTopologyTypes ()
+{
+	static const std::vector<MazeTopologyType> topologyTypes = {
+		MazeTopologyType::Square,
+		MazeTopologyType::Hex,
+		MazeTopologyType::Triangle,
+		MazeTopologyType::Polar
+	};
+	return topologyTypes;
+}
+
+}
@@ -0,0 +1,668 @@
+#ifndef MAZETOPOLOGIES_HPP
+#define MAZETOPOLOGIES_HPP
+
+#include "MazeGenerator.hpp"
+#include "WallCollector.hpp"
+#include "WallPolylines.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace MG
+{
+
+enum class MazeTopologyType
+{
+	Square,
+	Hex,
+	Triangle,
+	Polar
+};
+
+const char*								GetMazeTopologyName (MazeTopologyType topologyType);
+bool									FindMazeTopologyType (const std::string& name, MazeTopologyType& topologyType);
+const std::vector<MazeTopologyType>&	GetAllMazeTopologyTypes ();
+
+static const double TopologyPi = 3.14159265358979323846;
+
+class WallArc
+{
+public:
+	WallArc () :
+		WallArc (0.0, 0.0, 0.0, 0.0, 0.0)
+	{
+
+	}
+
+	WallArc (double centerX, double centerY, double radius, double begAngle, double endAngle) :
+		centerX (centerX),
+		centerY (centerY),
+		radius (radius),
+		begAngle (begAngle),
+		endAngle (endAngle)
+	{
+
+	}
+
+	double centerX;
+	double centerY;
+	double radius;
+	double begAngle;
+	double endAngle;
+};
+
+class PolarWallGeometry
+{
+public:
+	PolarWallGeometry () :
+		radialWalls (),
+		arcWalls ()
+	{
+
+	}
+
+	std::vector<WallGeometry>	radialWalls;
+	std::vector<WallArc>		arcWalls;
+};
+
+// A topology policy numbers the cells and wall slots of a grid. GetWallCells returns false for
+// slots that are not real walls, and the second cell is InvalidCellId on the outer border.
+class SquareTopology
+{
+public:
+	using Geometry = std::vector<WallGeometry>;
+
+	SquareTopology (int rowCount, int colCount) :
+		rows (std::max (rowCount, 0)),
+		cols (std::max (colCount, 0))
+	{
+
+	}
+
+	static const char* GetName ()
+	{
+		return "square";
+	}
+
+	int GetCellCount () const
+	{
+		return rows * cols;
+	}
+
+	int GetWallSlotCount () const
+	{
+		return (rows + 1) * cols + rows * (cols + 1);
+	}
+
+	bool GetWallCells (WallId wallId, CellId& cellId1, CellId& cellId2) const
+	{
+		int horizontalCount = (rows + 1) * cols;
+		if (wallId < horizontalCount) {
+			int line = wallId / cols;
+			int col = wallId % cols;
+			cellId1 = (line < rows ? line * cols + col : (line - 1) * cols + col);
+			cellId2 = (line > 0 && line < rows ? (line - 1) * cols + col : InvalidCellId);
+			return true;
+		}
+		int line = (wallId - horizontalCount) / rows;
+		int row = (wallId - horizontalCount) % rows;
+		cellId1 = (line < cols ? row * cols + line : row * cols + line - 1);
+		cellId2 = (line > 0 && line < cols ? row * cols + line - 1 : InvalidCellId);
+		return true;
+	}
+
+	template <typename WallProcessor>
+	void EnumerateCellWalls (CellId cellId, const WallProcessor& processor) const
+	{
+		int row = cellId / cols;
+		int col = cellId % cols;
+		int horizontalCount = (rows + 1) * cols;
+		processor (horizontalCount + col * rows + row, col > 0 ? cellId - 1 : InvalidCellId);
+		processor (horizontalCount + (col + 1) * rows + row, col + 1 < cols ? cellId + 1 : InvalidCellId);
+		processor (row * cols + col, row > 0 ? cellId - cols : InvalidCellId);
+		processor ((row + 1) * cols + col, row + 1 < rows ? cellId + cols : InvalidCellId);
+	}
+
+	WallId GetEntranceWall () const
+	{
+		return 0;
+	}
+
+	WallId GetExitWall () const
+	{
+		return rows * cols + cols - 1;
+	}
+
+	template <typename WallTester>
+	Geometry GetWallGeometries (const WallTester& hasWall, double cellSize) const
+	{
+		Geometry wallGeometries;
+		for (int line = 0; line <= rows; line++) {
+			WallCollector collector (wallGeometries, WallCollector::Direction::Horizontal, line * cellSize);
+			for (int col = 0; col < cols; col++) {
+				if (hasWall (line * cols + col)) {
+					collector.AddWall (col * cellSize, (col + 1) * cellSize);
+				}
+			}
+			collector.Flush ();
+		}
+		int horizontalCount = (rows + 1) * cols;
+		for (int line = 0; line <= cols; line++) {
+			WallCollector collector (wallGeometries, WallCollector::Direction::Vertical, line * cellSize);
+			for (int row = 0; row < rows; row++) {
+				if (hasWall (horizontalCount + line * rows + row)) {
+					collector.AddWall (row * cellSize, (row + 1) * cellSize);
+				}
+			}
+			collector.Flush ();
+		}
+		return wallGeometries;
+	}
+
+private:
+	int		rows;
+	int		cols;
+};
+
+// Pointy-top hexagons in rows, odd rows are shifted right by half a cell. Every cell owns
+// its west, north-west and north-east walls, east and south walls on the border get extra slots.
+class HexTopology
+{
+public:
+	using Geometry = WallPolylines;
+
+	static const int West = 0;
+	static const int NorthWest = 1;
+	static const int NorthEast = 2;
+	static const int East = 3;
+	static const int SouthEast = 4;
+	static const int SouthWest = 5;
+
+	HexTopology (int rowCount, int colCount) :
+		rows (std::max (rowCount, 0)),
+		cols (std::max (colCount, 0))
+	{
+
+	}
+
+	static const char* GetName ()
+	{
+		return "hex";
+	}
+
+	int GetCellCount () const
+	{
+		return rows * cols;
+	}
+
+	int GetWallSlotCount () const
+	{
+		return 6 * rows * cols;
+	}
+
+	CellId GetNeighbourCellId (CellId cellId, int dir) const
+	{
+		int row = cellId / cols;
+		int col = cellId % cols;
+		int shift = row % 2;
+		switch (dir) {
+		case West:
+			col -= 1;
+			break;
+		case East:
+			col += 1;
+			break;
+		case NorthWest:
+			row -= 1;
+			col -= 1 - shift;
+			break;
+		case NorthEast:
+			row -= 1;
+			col += shift;
+			break;
+		case SouthWest:
+			row += 1;
+			col -= 1 - shift;
+			break;
+		case SouthEast:
+			row += 1;
+			col += shift;
+			break;
+		default:
+			return InvalidCellId;
+		}
+		if (row < 0 || row >= rows || col < 0 || col >= cols) {
+			return InvalidCellId;
+		}
+		return row * cols + col;
+	}
+
+	WallId GetCellWall (CellId cellId, int dir) const
+	{
+		if (dir < East) {
+			return 3 * cellId + dir;
+		}
+		CellId neighbourId = GetNeighbourCellId (cellId, dir);
+		if (neighbourId != InvalidCellId) {
+			return 3 * neighbourId + dir - East;
+		}
+		return 3 * rows * cols + 3 * cellId + dir - East;
+	}
+
+	bool GetWallCells (WallId wallId, CellId& cellId1, CellId& cellId2) const
+	{
+		int ownedCount = 3 * rows * cols;
+		if (wallId < ownedCount) {
+			cellId1 = wallId / 3;
+			cellId2 = GetNeighbourCellId (cellId1, wallId % 3);
+			return true;
+		}
+		cellId1 = (wallId - ownedCount) / 3;
+		cellId2 = InvalidCellId;
+		return GetNeighbourCellId (cellId1, East + (wallId - ownedCount) % 3) == InvalidCellId;
+	}
+
+	template <typename WallProcessor>
+	void EnumerateCellWalls (CellId cellId, const WallProcessor& processor) const
+	{
+		for (int dir = West; dir <= SouthWest; dir++) {
+			processor (GetCellWall (cellId, dir), GetNeighbourCellId (cellId, dir));
+		}
+	}
+
+	WallId GetEntranceWall () const
+	{
+		return NorthWest;
+	}
+
+	WallId GetExitWall () const
+	{
+		return GetCellWall (rows * cols - 1, SouthEast);
+	}
+
+	template <typename WallTester>
+	Geometry GetWallGeometries (const WallTester& hasWall, double cellSize) const
+	{
+		Geometry polylines;
+		bool open = false;
+		auto addEdge = [&] (const WallPoint& beg, const WallPoint& end) {
+			if (!open) {
+				polylines.points.push_back (beg);
+				open = true;
+			}
+			polylines.points.push_back (end);
+		};
+		auto closePolyline = [&] () {
+			if (open) {
+				polylines.polylineEnds.push_back (polylines.points.size ());
+				open = false;
+			}
+		};
+
+		for (int row = 0; row < rows; row++) {
+			for (int col = 0; col < cols; col++) {
+				CellId cellId = row * cols + col;
+				for (int dir = NorthWest; dir <= NorthEast; dir++) {
+					if (hasWall (3 * cellId + dir)) {
+						addEdge (GetCorner (row, col, dir + 3, cellSize), GetCorner (row, col, dir + 4, cellSize));
+					} else {
+						closePolyline ();
+					}
+				}
+			}
+			closePolyline ();
+		}
+		for (int col = 0; col < cols && rows > 0; col++) {
+			CellId cellId = (rows - 1) * cols + col;
+			for (int dir = SouthWest; dir >= SouthEast; dir--) {
+				if (hasWall (GetCellWall (cellId, dir))) {
+					addEdge (GetCorner (rows - 1, col, dir + 4, cellSize), GetCorner (rows - 1, col, dir + 3, cellSize));
+				} else {
+					closePolyline ();
+				}
+			}
+		}
+		closePolyline ();
+
+		for (CellId cellId = 0; cellId < rows * cols; cellId++) {
+			int row = cellId / cols;
+			int col = cellId % cols;
+			for (int dir = West; dir <= SouthWest; dir++) {
+				bool zigzagWall = (dir == NorthWest || dir == NorthEast || (row == rows - 1 && (dir == SouthWest || dir == SouthEast)));
+				if (zigzagWall || (dir != West && GetNeighbourCellId (cellId, dir) != InvalidCellId) || !hasWall (GetCellWall (cellId, dir))) {
+					continue;
+				}
+				addEdge (GetCorner (row, col, dir + 3, cellSize), GetCorner (row, col, dir + 4, cellSize));
+				closePolyline ();
+			}
+		}
+		return polylines;
+	}
+
+private:
+	WallPoint GetCorner (int row, int col, int corner, double cellSize) const
+	{
+		double radius = cellSize / std::sqrt (3.0);
+		double centerX = cellSize * (col + 0.5 + 0.5 * (row % 2));
+		double centerY = radius * (1.0 + 1.5 * row);
+		double angle = TopologyPi / 3.0 * (corner % 6) - TopologyPi / 6.0;
+		return WallPoint (centerX + radius * std::cos (angle), centerY + radius * std::sin (angle));
+	}
+
+	int		rows;
+	int		cols;
+};
+
+// Rows of alternating up and down pointing triangles, the cell at (0, 0) points up.
+// Horizontal walls use the same line layout as the square grid, slanted walls follow them.
+class TriangleTopology
+{
+public:
+	using Geometry = std::vector<WallGeometry>;
+
+	TriangleTopology (int rowCount, int colCount) :
+		rows (std::max (rowCount, 0)),
+		cols (std::max (colCount, 0))
+	{
+
+	}
+
+	static const char* GetName ()
+	{
+		return "triangle";
+	}
+
+	int GetCellCount () const
+	{
+		return rows * cols;
+	}
+
+	int GetWallSlotCount () const
+	{
+		return (rows + 1) * cols + rows * (cols + 1);
+	}
+
+	bool GetWallCells (WallId wallId, CellId& cellId1, CellId& cellId2) const
+	{
+		int horizontalCount = (rows + 1) * cols;
+		if (wallId < horizontalCount) {
+			int line = wallId / cols;
+			int col = wallId % cols;
+			cellId1 = (line < rows ? line * cols + col : (line - 1) * cols + col);
+			cellId2 = (line > 0 && line < rows ? (line - 1) * cols + col : InvalidCellId);
+			return (line + col) % 2 == 1;
+		}
+		int row = (wallId - horizontalCount) / (cols + 1);
+		int line = (wallId - horizontalCount) % (cols + 1);
+		cellId1 = (line < cols ? row * cols + line : row * cols + line - 1);
+		cellId2 = (line > 0 && line < cols ? row * cols + line - 1 : InvalidCellId);
+		return true;
+	}
+
+	template <typename WallProcessor>
+	void EnumerateCellWalls (CellId cellId, const WallProcessor& processor) const
+	{
+		int row = cellId / cols;
+		int col = cellId % cols;
+		int horizontalCount = (rows + 1) * cols;
+		processor (horizontalCount + row * (cols + 1) + col, col > 0 ? cellId - 1 : InvalidCellId);
+		processor (horizontalCount + row * (cols + 1) + col + 1, col + 1 < cols ? cellId + 1 : InvalidCellId);
+		if ((row + col) % 2 == 0) {
+			processor ((row + 1) * cols + col, row + 1 < rows ? cellId + cols : InvalidCellId);
+		} else {
+			processor (row * cols + col, row > 0 ? cellId - cols : InvalidCellId);
+		}
+	}
+
+	WallId GetEntranceWall () const
+	{
+		return (rows + 1) * cols;
+	}
+
+	WallId GetExitWall () const
+	{
+		return (rows + 1) * cols + rows * (cols + 1) - 1;
+	}
+
+	template <typename WallTester>
+	Geometry GetWallGeometries (const WallTester& hasWall, double cellSize) const
+	{
+		Geometry wallGeometries;
+		double halfSize = cellSize / 2.0;
+		double height = cellSize * std::sqrt (3.0) / 2.0;
+		for (int line = 0; line <= rows; line++) {
+			WallCollector collector (wallGeometries, WallCollector::Direction::Horizontal, line * height);
+			for (int col = (line + 1) % 2; col < cols; col += 2) {
+				if (hasWall (line * cols + col)) {
+					collector.AddWall (col * halfSize, col * halfSize + cellSize);
+				}
+			}
+			collector.Flush ();
+		}
+
+		int horizontalCount = (rows + 1) * cols;
+		auto addDiagonal = [&] (int diagonal, int step) {
+			bool open = false;
+			WallGeometry wall;
+			for (int row = 0; row < rows; row++) {
+				int line = diagonal + step * row;
+				bool present = (line >= 0 && line <= cols && hasWall (horizontalCount + row * (cols + 1) + line));
+				if (present) {
+					double topX = (step < 0 ? line + 1 : line) * halfSize;
+					double bottomX = (step < 0 ? line : line + 1) * halfSize;
+					if (!open) {
+						wall.begX = topX;
+						wall.begY = row * height;
+						open = true;
+					}
+					wall.endX = bottomX;
+					wall.endY = (row + 1) * height;
+				} else if (open) {
+					wallGeometries.push_back (wall);
+					open = false;
+				}
+			}
+			if (open) {
+				wallGeometries.push_back (wall);
+			}
+		};
+		for (int diagonal = 0; diagonal <= rows + cols; diagonal += 2) {
+			addDiagonal (diagonal, -1);
+		}
+		for (int diagonal = 1 - 2 * ((rows + 1) / 2); diagonal <= cols; diagonal += 2) {
+			addDiagonal (diagonal, 1);
+		}
+		return wallGeometries;
+	}
+
+private:
+	int		rows;
+	int		cols;
+};
+
+// Concentric rings around a single center cell. The first ring has colCount cells, and the
+// cells of outer rings are split whenever they would get wider than twice the ring height.
+class PolarTopology
+{
+public:
+	using Geometry = PolarWallGeometry;
+
+	PolarTopology (int rowCount, int colCount) :
+		rings (std::max (rowCount, 1)),
+		ringOffsets ()
+	{
+		ringOffsets.push_back (0);
+		ringOffsets.push_back (1);
+		for (int ring = 1; ring < rings; ring++) {
+			int previousCount = ringOffsets[ring] - ringOffsets[ring - 1];
+			int cellCount = std::max (colCount, 1);
+			if (ring > 1) {
+				double cellWidth = 2.0 * TopologyPi * ring / previousCount;
+				cellCount = previousCount * std::max ((int) std::lround (cellWidth), 1);
+			}
+			ringOffsets.push_back (ringOffsets.back () + cellCount);
+		}
+	}
+
+	static const char* GetName ()
+	{
+		return "polar";
+	}
+
+	int GetCellCount () const
+	{
+		return ringOffsets.back ();
+	}
+
+	int GetWallSlotCount () const
+	{
+		return 2 * GetCellCount () + GetRingCellCount (rings - 1);
+	}
+
+	int GetRingCount () const
+	{
+		return rings;
+	}
+
+	int GetRingCellCount (int ring) const
+	{
+		return ringOffsets[ring + 1] - ringOffsets[ring];
+	}
+
+	int GetCellRing (CellId cellId) const
+	{
+		return (int) (std::upper_bound (ringOffsets.begin (), ringOffsets.end (), cellId) - ringOffsets.begin ()) - 1;
+	}
+
+	bool GetWallCells (WallId wallId, CellId& cellId1, CellId& cellId2) const
+	{
+		int cellCount = GetCellCount ();
+		if (wallId >= 2 * cellCount) {
+			cellId1 = ringOffsets[rings - 1] + wallId - 2 * cellCount;
+			cellId2 = InvalidCellId;
+			return true;
+		}
+		cellId1 = wallId / 2;
+		int ring = GetCellRing (cellId1);
+		if (ring == 0) {
+			return false;
+		}
+		int ringCellCount = GetRingCellCount (ring);
+		int index = cellId1 - ringOffsets[ring];
+		if (wallId % 2 == 0) {
+			cellId2 = ringOffsets[ring - 1] + index / (ringCellCount / GetRingCellCount (ring - 1));
+			return true;
+		}
+		cellId2 = ringOffsets[ring] + (index + 1) % ringCellCount;
+		return ringCellCount > 1;
+	}
+
+	template <typename WallProcessor>
+	void EnumerateCellWalls (CellId cellId, const WallProcessor& processor) const
+	{
+		int ring = GetCellRing (cellId);
+		int ringCellCount = GetRingCellCount (ring);
+		int index = cellId - ringOffsets[ring];
+		if (ring > 0) {
+			processor (2 * cellId, ringOffsets[ring - 1] + index / (ringCellCount / GetRingCellCount (ring - 1)));
+			if (ringCellCount > 1) {
+				CellId previousCellId = ringOffsets[ring] + (index + ringCellCount - 1) % ringCellCount;
+				processor (2 * cellId + 1, ringOffsets[ring] + (index + 1) % ringCellCount);
+				processor (2 * previousCellId + 1, previousCellId);
+			}
+		}
+		if (ring + 1 == rings) {
+			processor (2 * GetCellCount () + index, InvalidCellId);
+			return;
+		}
+		int ratio = GetRingCellCount (ring + 1) / ringCellCount;
+		for (int child = 0; child < ratio; child++) {
+			CellId childCellId = ringOffsets[ring + 1] + index * ratio + child;
+			processor (2 * childCellId, childCellId);
+		}
+	}
+
+	WallId GetEntranceWall () const
+	{
+		return 2 * GetCellCount ();
+	}
+
+	WallId GetExitWall () const
+	{
+		return InvalidWallId;
+	}
+
+	template <typename WallTester>
+	Geometry GetWallGeometries (const WallTester& hasWall, double cellSize) const
+	{
+		Geometry geometry;
+		double center = rings * cellSize;
+		for (int ring = 1; ring <= rings; ring++) {
+			int cellCount = GetRingCellCount (ring < rings ? ring : rings - 1);
+			auto hasArc = [&] (int index) {
+				return (ring < rings ? hasWall (2 * (ringOffsets[ring] + index)) : hasWall (2 * GetCellCount () + index));
+			};
+			int begIndex = 0;
+			while (begIndex < cellCount && hasArc (begIndex)) {
+				begIndex++;
+			}
+			double angleStep = 2.0 * TopologyPi / cellCount;
+			if (begIndex == cellCount) {
+				geometry.arcWalls.push_back (WallArc (center, center, ring * cellSize, 0.0, 2.0 * TopologyPi));
+				continue;
+			}
+			for (int offset = 1; offset <= cellCount; offset++) {
+				int index = (begIndex + offset) % cellCount;
+				if (!hasArc (index)) {
+					continue;
+				}
+				int runLength = 1;
+				while (runLength < cellCount && hasArc ((index + runLength) % cellCount)) {
+					runLength++;
+				}
+				geometry.arcWalls.push_back (WallArc (center, center, ring * cellSize, index * angleStep, (index + runLength) * angleStep));
+				offset += runLength;
+			}
+		}
+
+		for (int ring = 1; ring < rings; ring++) {
+			int cellCount = GetRingCellCount (ring);
+			if (cellCount == 1) {
+				continue;
+			}
+			int ratio = cellCount / GetRingCellCount (ring - 1);
+			for (int index = 0; index < cellCount; index++) {
+				int angleIndex = index + 1;
+				if (!hasWall (2 * (ringOffsets[ring] + index) + 1)) {
+					continue;
+				}
+				if (ring > 1 && angleIndex % ratio == 0 && hasWall (2 * (ringOffsets[ring - 1] + angleIndex / ratio - 1) + 1)) {
+					continue;
+				}
+				int endRing = ring + 1;
+				while (endRing < rings) {
+					int nextRatio = GetRingCellCount (endRing) / GetRingCellCount (endRing - 1);
+					angleIndex *= nextRatio;
+					if (!hasWall (2 * (ringOffsets[endRing] + angleIndex - 1) + 1)) {
+						break;
+					}
+					endRing++;
+				}
+				double angle = 2.0 * TopologyPi * (index + 1) / cellCount;
+				double dx = std::cos (angle) * cellSize;
+				double dy = std::sin (angle) * cellSize;
+				geometry.radialWalls.push_back (WallGeometry (center + dx * ring, center + dy * ring, center + dx * endRing, center + dy * endRing));
+			}
+		}
+		return geometry;
+	}
+
+private:
+	int					rings;
+	std::vector<int>	ringOffsets;
+};
+
+}
+
+#endif
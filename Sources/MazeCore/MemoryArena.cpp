@@ -0,0 +1,86 @@
+#include "MemoryArena.hpp"
+
+#include <algorithm>
+
+namespace MG
+{
+
+static const size_t DefaultArenaBlockSize = 64 * 1024;
+
+MemoryArena::MemoryArena () :
+	MemoryArena (DefaultArenaBlockSize)
+{
+
+}
+
+MemoryArena::MemoryArena (size_t initialCapacity) :
+	blocks (),
+	initialCapacity (std::max (initialCapacity, (size_t) 1)),
+	capacity (0),
+	lastBlockSize (0),
+	usedSize (0),
+	blockAllocationCount (0),
+	current (nullptr),
+	end (nullptr)
+{
+
+}
+
+MemoryArena::~MemoryArena ()
+{
+
+}
+
+void* MemoryArena::Allocate (size_t size, size_t alignment)
+{
+	std::uintptr_t address = ((std::uintptr_t) current + alignment - 1) & ~(std::uintptr_t) (alignment - 1);
+	if (current == nullptr || address > (std::uintptr_t) end || size > (std::uintptr_t) end - address) {
+		AddBlock (size + alignment);
+		address = ((std::uintptr_t) current + alignment - 1) & ~(std::uintptr_t) (alignment - 1);
+	}
+	current = (unsigned char*) (address + size);
+	usedSize += size;
+	return (void*) address;
+}
+
+void MemoryArena::Reset ()
+{
+	if (blocks.size () > 1) {
+		size_t totalCapacity = capacity;
+		blocks.clear ();
+		capacity = 0;
+		AddBlock (totalCapacity);
+	} else if (blocks.size () == 1) {
+		current = blocks.front ().get ();
+		end = current + lastBlockSize;
+	}
+	usedSize = 0;
+}
+
+size_t MemoryArena::GetUsedSize () const
+{
+	return usedSize;
+}
+
+size_t MemoryArena::GetCapacity () const
+{
+	return capacity;
+}
+
+size_t MemoryArena::GetBlockAllocationCount () const
+{
+	return blockAllocationCount;
+}
+
+void MemoryArena::AddBlock (size_t minSize)
+{
+	size_t blockSize = std::max (minSize, std::max (initialCapacity, capacity));
+	blocks.push_back (std::unique_ptr<unsigned char[]> (new unsigned char[blockSize]));
+	capacity += blockSize;
+	lastBlockSize = blockSize;
+	blockAllocationCount += 1;
+	current = blocks.back ().get ();
+	end = current + blockSize;
+}
+
+}
@@ -0,0 +1,116 @@
+#ifndef MEMORYARENA_HPP
+#define MEMORYARENA_HPP
+
+#include <vector>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+
+namespace MG
+{
+
+class MemoryArena
+{
+public:
+	MemoryArena ();
+	explicit MemoryArena (size_t initialCapacity);
+	MemoryArena (const MemoryArena&) = delete;
+	MemoryArena& operator= (const MemoryArena&) = delete;
+	~MemoryArena ();
+
+	void*	Allocate (size_t size, size_t alignment);
+	void	Reset ();
+
+	size_t	GetUsedSize () const;
+	size_t	GetCapacity () const;
+	size_t	GetBlockAllocationCount () const;
+
+private:
+	void	AddBlock (size_t minSize);
+
+	std::vector<std::unique_ptr<unsigned char[]>>	blocks;
+	size_t											initialCapacity;
+	size_t											capacity;
+	size_t											lastBlockSize;
+	size_t											usedSize;
+	size_t											blockAllocationCount;
+	unsigned char*									current;
+	unsigned char*									end;
+};
+
+template <typename T>
+class ArenaAllocator
+{
+public:
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::false_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	ArenaAllocator () :
+		arena (nullptr)
+	{
+
+	}
+
+	explicit ArenaAllocator (MemoryArena* arena) :
+		arena (arena)
+	{
+
+	}
+
+	template <typename U>
+	ArenaAllocator (const ArenaAllocator<U>& other) :
+		arena (other.GetArena ())
+	{
+
+	}
+
+	T* allocate (size_t count)
+	{
+		if (arena == nullptr) {
+			return static_cast<T*> (::operator new (count * sizeof (T)));
+		}
+		return static_cast<T*> (arena->Allocate (count * sizeof (T), alignof (T)));
+	}
+
+	void deallocate (T* pointer, size_t)
+	{
+		if (arena == nullptr) {
+			::operator delete (pointer);
+		}
+	}
+
+	ArenaAllocator select_on_container_copy_construction () const
+	{
+		return ArenaAllocator ();
+	}
+
+	MemoryArena* GetArena () const
+	{
+		return arena;
+	}
+
+private:
+	MemoryArena*	arena;
+};
+
+template <typename T, typename U>
+bool operator== (const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+	return lhs.GetArena () == rhs.GetArena ();
+}
+
+template <typename T, typename U>
+bool operator!= (const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs)
+{
+	return lhs.GetArena () != rhs.GetArena ();
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+}
+
+#endif
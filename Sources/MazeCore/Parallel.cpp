@@ -0,0 +1,58 @@
+#include "Parallel.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace MG
+{
+
+int GetDefaultThreadCount ()
+{
+	unsigned int hardwareThreads = std::thread::hardware_concurrency ();
+	return (hardwareThreads == 0 ? 1 : (int) hardwareThreads);
+}
+
+int GetEffectiveThreadCount (int threadCount, int taskCount)
+{
+	if (threadCount <= 0) {
+		threadCount = GetDefaultThreadCount ();
+	}
+	if (threadCount > taskCount) {
+		threadCount = taskCount;
+	}
+	return (threadCount < 1 ? 1 : threadCount);
+}
+
+void ParallelFor (int taskCount, int threadCount, const ParallelTask& task)
+{
+	if (taskCount <= 0) {
+		return;
+	}
+
+	threadCount = GetEffectiveThreadCount (threadCount, taskCount);
+	if (threadCount == 1) {
+		for (int taskIndex = 0; taskIndex < taskCount; taskIndex++) {
+			task (taskIndex, 0);
+		}
+		return;
+	}
+
+	std::atomic<int> nextTaskIndex (0);
+	auto worker = [&] (int threadIndex) {
+		for (int taskIndex = nextTaskIndex++; taskIndex < taskCount; taskIndex = nextTaskIndex++) {
+			task (taskIndex, threadIndex);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	for (int threadIndex = 1; threadIndex < threadCount; threadIndex++) {
+		threads.push_back (std::thread (worker, threadIndex));
+	}
+	worker (0);
+	for (std::thread& thread : threads) {
+		thread.join ();
+	}
+}
+
+}
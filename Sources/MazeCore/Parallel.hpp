@@ -0,0 +1,17 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <functional>
+
+namespace MG
+{
+
+using ParallelTask = std::function<void (int taskIndex, int threadIndex)>;
+
+int		GetDefaultThreadCount ();
+int		GetEffectiveThreadCount (int threadCount, int taskCount);
+void	ParallelFor (int taskCount, int threadCount, const ParallelTask& task);
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+#include "ParallelMazeGenerator.hpp"
+#include "MazeAlgorithms.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+
+namespace MG
+{
+
+ParallelMazeGenerator::ParallelMazeGenerator (int rowCount, int colCount, std::uint64_t seed, int threadCount, MazeAlgorithmType algorithmType) :
+	maze (),
+	rowCount (rowCount),
+	colCount (colCount),
+	seed (seed),
+	threadCount (threadCount),
+	algorithmType (algorithmType),
+	tileSize (DefaultTileSize),
+	tileRowCount (0),
+	tileColCount (0)
+{
+
+}
+
+void ParallelMazeGenerator::SetTileSize (int newTileSize)
+{
+	// Tiles cover whole wall words, so two workers never write the same word.
+	int wordCount = std::max ((newTileSize + WallWordBits - 1) / WallWordBits, 1);
+	tileSize = wordCount * WallWordBits;
+}
+
+int ParallelMazeGenerator::GetTileSize () const
+{
+	return tileSize;
+}
+
+bool ParallelMazeGenerator::Generate ()
+{
+	if (rowCount <= 0 || colCount <= 0) {
+		return false;
+	}
+
+	maze.Reset (rowCount, colCount);
+	tileRowCount = (rowCount + tileSize - 1) / tileSize;
+	tileColCount = (colCount + tileSize - 1) / tileSize;
+	int tileCount = tileRowCount * tileColCount;
+
+	int workerCount = GetEffectiveThreadCount (threadCount, tileCount);
+	std::vector<Maze> tileMazes (workerCount);
+	std::vector<std::unique_ptr<MazeAlgorithm>> tileAlgorithms;
+	for (int i = 0; i < workerCount; i++) {
+		tileAlgorithms.push_back (CreateMazeAlgorithm (algorithmType));
+		if (tileAlgorithms.back () == nullptr) {
+			return false;
+		}
+	}
+
+	ParallelFor (tileCount, workerCount, [&] (int tileIndex, int threadIndex) {
+		GenerateTile (tileIndex, tileMazes[threadIndex], *tileAlgorithms[threadIndex]);
+	});
+	ConnectTiles ();
+
+	WallId entrance = maze.GetWallId (0, 0, Direction::Top);
+	WallId exit = maze.GetWallId (rowCount - 1, colCount - 1, Direction::Bottom);
+	maze.RemoveWall (entrance);
+	maze.RemoveWall (exit);
+
+	return true;
+}
+
+const Maze& ParallelMazeGenerator::GetMaze () const
+{
+	return maze;
+}
+
+void ParallelMazeGenerator::GenerateTile (int tileIndex, Maze& tileMaze, MazeAlgorithm& tileAlgorithm)
+{
+	int begRow = (tileIndex / tileColCount) * tileSize;
+	int begCol = (tileIndex % tileColCount) * tileSize;
+	int tileRows = std::min (tileSize, rowCount - begRow);
+	int tileCols = std::min (tileSize, colCount - begCol);
+
+	Xoshiro256Engine tileRandomEngine (DeriveSeed (seed, (std::uint64_t) tileIndex + 1));
+	tileMaze.Reset (tileRows, tileCols);
+	tileAlgorithm.Generate (tileMaze, tileRandomEngine);
+
+	maze.CopyTileWalls (tileMaze, begRow, begCol);
+}
+
+void ParallelMazeGenerator::ConnectTiles ()
+{
+	int tileCount = tileRowCount * tileColCount;
+	std::vector<int> parents (tileCount);
+	for (int tileIndex = 0; tileIndex < tileCount; tileIndex++) {
+		parents[tileIndex] = tileIndex;
+	}
+	auto findSet = [&] (int tileIndex) {
+		while (parents[tileIndex] != tileIndex) {
+			parents[tileIndex] = parents[parents[tileIndex]];
+			tileIndex = parents[tileIndex];
+		}
+		return tileIndex;
+	};
+
+	std::vector<std::pair<int, Direction>> tileEdges;
+	for (int tileIndex = 0; tileIndex < tileCount; tileIndex++) {
+		if (tileIndex % tileColCount + 1 < tileColCount) {
+			tileEdges.push_back ({ tileIndex, Direction::Right });
+		}
+		if (tileIndex / tileColCount + 1 < tileRowCount) {
+			tileEdges.push_back ({ tileIndex, Direction::Bottom });
+		}
+	}
+
+	Xoshiro256Engine randomEngine (DeriveSeed (seed, 0));
+	for (size_t i = tileEdges.size (); i > 1; i--) {
+		size_t j = randomEngine.NextBelow ((std::uint32_t) i);
+		std::swap (tileEdges[i - 1], tileEdges[j]);
+	}
+
+	for (const std::pair<int, Direction>& tileEdge : tileEdges) {
+		int tileIndex = tileEdge.first;
+		Direction dir = tileEdge.second;
+		int otherTileIndex = (dir == Direction::Right ? tileIndex + 1 : tileIndex + tileColCount);
+		int set1 = findSet (tileIndex);
+		int set2 = findSet (otherTileIndex);
+		if (set1 == set2) {
+			continue;
+		}
+		parents[set2] = set1;
+
+		int begRow = (tileIndex / tileColCount) * tileSize;
+		int begCol = (tileIndex % tileColCount) * tileSize;
+		if (dir == Direction::Right) {
+			int borderLength = std::min (tileSize, rowCount - begRow);
+			int row = begRow + (int) randomEngine.NextBelow ((std::uint32_t) borderLength);
+			maze.RemoveWall (maze.ComputeWallId (row, begCol + tileSize - 1, Direction::Right));
+		} else {
+			int borderLength = std::min (tileSize, colCount - begCol);
+			int col = begCol + (int) randomEngine.NextBelow ((std::uint32_t) borderLength);
+			maze.RemoveWall (maze.ComputeWallId (begRow + tileSize - 1, col, Direction::Bottom));
+		}
+	}
+}
+
+}
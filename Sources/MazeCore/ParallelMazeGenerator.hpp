@@ -0,0 +1,39 @@
+#ifndef PARALLELMAZEGENERATOR_HPP
+#define PARALLELMAZEGENERATOR_HPP
+
+#include "MazeGenerator.hpp"
+
+namespace MG
+{
+
+class ParallelMazeGenerator
+{
+public:
+	static const int DefaultTileSize = 256;
+
+	ParallelMazeGenerator (int rowCount, int colCount, std::uint64_t seed, int threadCount, MazeAlgorithmType algorithmType = MazeAlgorithmType::Prim);
+
+	void			SetTileSize (int newTileSize);
+	int				GetTileSize () const;
+
+	bool			Generate ();
+	const Maze&		GetMaze () const;
+
+private:
+	void			GenerateTile (int tileIndex, Maze& tileMaze, MazeAlgorithm& tileAlgorithm);
+	void			ConnectTiles ();
+
+	Maze				maze;
+	int					rowCount;
+	int					colCount;
+	std::uint64_t		seed;
+	int					threadCount;
+	MazeAlgorithmType	algorithmType;
+	int					tileSize;
+	int					tileRowCount;
+	int					tileColCount;
+};
+
+}
+
+#endif
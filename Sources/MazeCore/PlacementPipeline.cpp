@@ -0,0 +1,370 @@
+#include "PlacementPipeline.hpp"
+#include "MazeStreaming.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace MG
+{
+
+using Clock = std::chrono::steady_clock;
+
+static double GetElapsedMs (Clock::time_point startTime)
+{
+	return std::chrono::duration<double, std::milli> (Clock::now () - startTime).count ();
+}
+
+static void CopyPolylines (const WallPolylines& source, size_t begIndex, size_t endIndex, WallPolylines& target)
+{
+	const WallPoint* begPoint = source.GetPoints (begIndex);
+	const WallPoint* endPoint = source.GetPoints (endIndex - 1) + source.GetPointCount (endIndex - 1);
+	target.points.assign (begPoint, endPoint);
+	target.polylineEnds.clear ();
+	size_t pointOffset = begPoint - source.points.data ();
+	for (size_t polylineIndex = begIndex; polylineIndex < endIndex; polylineIndex++) {
+		target.polylineEnds.push_back (source.polylineEnds[polylineIndex] - pointOffset);
+	}
+}
+
+class WallChunk
+{
+public:
+	WallChunk ();
+
+	size_t						GetWallCount () const;
+
+	std::vector<WallGeometry>	walls;
+	WallPolylines				polylines;
+	size_t						totalWallCount;
+	double						completedFraction;
+};
+
+WallChunk::WallChunk () :
+	walls (),
+	polylines (),
+	totalWallCount (0),
+	completedFraction (0.0)
+{
+
+}
+
+size_t WallChunk::GetWallCount () const
+{
+	return walls.size () + polylines.GetPolylineCount ();
+}
+
+enum class WallChunkPopResult
+{
+	Popped,
+	TimedOut,
+	Finished
+};
+
+class WallChunkQueue
+{
+public:
+	WallChunkQueue (size_t maxChunkCount, CancellationToken& cancellationToken);
+
+	bool				Push (WallChunk& chunk);
+	WallChunkPopResult	Pop (WallChunk& chunk, std::chrono::milliseconds timeout);
+	void				Finish (bool succeeded, double generationMs);
+	void				Stop ();
+
+	bool				Succeeded () const;
+	double				GetGenerationMs () const;
+
+private:
+	std::mutex				mutex;
+	std::condition_variable	changed;
+	std::deque<WallChunk>	chunks;
+	size_t					maxChunkCount;
+	CancellationToken&		cancellationToken;
+	bool					finished;
+	bool					stopped;
+	bool					succeeded;
+	double					generationMs;
+};
+
+WallChunkQueue::WallChunkQueue (size_t maxChunkCount, CancellationToken& cancellationToken) :
+	mutex (),
+	changed (),
+	chunks (),
+	maxChunkCount (maxChunkCount),
+	cancellationToken (cancellationToken),
+	finished (false),
+	stopped (false),
+	succeeded (false),
+	generationMs (0.0)
+{
+
+}
+
+bool WallChunkQueue::Push (WallChunk& chunk)
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	changed.wait (lock, [&] () {
+		return chunks.size () < maxChunkCount || stopped || cancellationToken.IsCancelled ();
+	});
+	if (stopped || cancellationToken.IsCancelled ()) {
+		return false;
+	}
+	chunks.push_back (std::move (chunk));
+	chunk = WallChunk ();
+	changed.notify_all ();
+	return true;
+}
+
+WallChunkPopResult WallChunkQueue::Pop (WallChunk& chunk, std::chrono::milliseconds timeout)
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	bool ready = changed.wait_for (lock, timeout, [&] () {
+		return !chunks.empty () || finished;
+	});
+	if (!ready) {
+		return WallChunkPopResult::TimedOut;
+	}
+	if (chunks.empty ()) {
+		return WallChunkPopResult::Finished;
+	}
+	chunk = std::move (chunks.front ());
+	chunks.pop_front ();
+	changed.notify_all ();
+	return WallChunkPopResult::Popped;
+}
+
+void WallChunkQueue::Finish (bool newSucceeded, double newGenerationMs)
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	finished = true;
+	succeeded = newSucceeded;
+	generationMs = newGenerationMs;
+	changed.notify_all ();
+}
+
+void WallChunkQueue::Stop ()
+{
+	std::lock_guard<std::mutex> lock (mutex);
+	stopped = true;
+	changed.notify_all ();
+}
+
+bool WallChunkQueue::Succeeded () const
+{
+	return succeeded;
+}
+
+double WallChunkQueue::GetGenerationMs () const
+{
+	return generationMs;
+}
+
+const int PlacementPipeline::ProgressHeartbeatMs;
+
+PlacementProgress::PlacementProgress () :
+	placedWallCount (0),
+	placedChunkCount (0),
+	completedFraction (0.0)
+{
+
+}
+
+PlacementChunkStats::PlacementChunkStats () :
+	wallCount (0),
+	failedWallCount (0),
+	waitMs (0.0),
+	placementMs (0.0)
+{
+
+}
+
+PlacementResult::PlacementResult () :
+	status (PlacementStatus::Completed),
+	placedWallCount (0),
+	failedWallCount (0),
+	generationMs (0.0),
+	totalMs (0.0),
+	chunks ()
+{
+
+}
+
+PlacementPipeline::PlacementPipeline (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType, double cellSize) :
+	rowCount (rowCount),
+	colCount (colCount),
+	seed (seed),
+	algorithmType (algorithmType),
+	cellSize (cellSize),
+	chunkSize (DefaultChunkSize),
+	progressCallback (),
+	mazeCache (nullptr),
+	mergeWalls (false)
+{
+
+}
+
+void PlacementPipeline::SetChunkSize (size_t newChunkSize)
+{
+	chunkSize = (newChunkSize > 0 ? newChunkSize : DefaultChunkSize);
+}
+
+void PlacementPipeline::SetProgressCallback (const PlacementProgressCallback& newProgressCallback)
+{
+	progressCallback = newProgressCallback;
+}
+
+void PlacementPipeline::SetMazeCache (MazeCache* newMazeCache)
+{
+	mazeCache = newMazeCache;
+}
+
+void PlacementPipeline::SetMergeWalls (bool newMergeWalls)
+{
+	mergeWalls = newMergeWalls;
+}
+
+PlacementResult PlacementPipeline::Run (WallPlacementBackend& backend, CancellationToken& cancellationToken)
+{
+	Clock::time_point startTime = Clock::now ();
+	PlacementResult result;
+	WallChunkQueue queue (MaxQueuedChunkCount, cancellationToken);
+
+	std::thread producer ([&] () {
+		Clock::time_point generationStartTime = Clock::now ();
+		bool succeeded = true;
+		WallChunk chunk;
+		if (algorithmType == MazeAlgorithmType::Eller && mazeCache == nullptr && !mergeWalls) {
+			// A perfect maze opens cellCount - 1 passages plus the entrance and the exit, merging can only lower the rest.
+			size_t wallSlotCount = (size_t) (rowCount + 1) * colCount + (size_t) rowCount * (colCount + 1);
+			size_t maxWallCount = wallSlotCount - std::min (wallSlotCount, (size_t) rowCount * colCount + 1);
+			StreamingMazeGenerator generator (rowCount, colCount, seed);
+			succeeded = generator.Generate (cellSize, [&] (int row, const std::vector<WallGeometry>& finishedWalls) {
+				chunk.walls.insert (chunk.walls.end (), finishedWalls.begin (), finishedWalls.end ());
+				chunk.totalWallCount = maxWallCount;
+				chunk.completedFraction = (double) (row + 1) / rowCount;
+				if (cancellationToken.IsCancelled ()) {
+					return false;
+				}
+				if (chunk.walls.size () >= chunkSize || row == rowCount - 1) {
+					return queue.Push (chunk);
+				}
+				return true;
+			});
+		} else if (mergeWalls) {
+			WallPolylines polylines;
+			if (mazeCache != nullptr) {
+				std::shared_ptr<const Maze> maze = mazeCache->GetMaze (MazeCacheKey (rowCount, colCount, seed, algorithmType));
+				succeeded = (maze != nullptr);
+				if (succeeded) {
+					polylines = TraceWallPolylines (maze->GetWallBits (), cellSize);
+				}
+			} else {
+				MazeGenerator generator (rowCount, colCount, seed, algorithmType);
+				generator.SetCancellationToken (&cancellationToken);
+				succeeded = generator.Generate ();
+				if (succeeded) {
+					polylines = TraceWallPolylines (generator.GetMaze ().GetWallBits (), cellSize);
+				}
+			}
+			size_t polylineCount = polylines.GetPolylineCount ();
+			for (size_t chunkBeg = 0; succeeded && chunkBeg < polylineCount; chunkBeg += chunkSize) {
+				size_t chunkEnd = std::min (chunkBeg + chunkSize, polylineCount);
+				CopyPolylines (polylines, chunkBeg, chunkEnd, chunk.polylines);
+				chunk.totalWallCount = polylineCount;
+				chunk.completedFraction = (double) chunkEnd / polylineCount;
+				succeeded = queue.Push (chunk);
+			}
+		} else {
+			std::shared_ptr<const std::vector<WallGeometry>> walls;
+			if (mazeCache != nullptr) {
+				walls = mazeCache->GetWallGeometries (MazeCacheKey (rowCount, colCount, seed, algorithmType), cellSize);
+			} else {
+				MazeGenerator generator (rowCount, colCount, seed, algorithmType);
+				generator.SetCancellationToken (&cancellationToken);
+				if (generator.Generate ()) {
+					walls = std::make_shared<const std::vector<WallGeometry>> (generator.GetMaze ().GetWallGeometries (cellSize, 0));
+				}
+			}
+			succeeded = (walls != nullptr);
+			for (size_t chunkBeg = 0; succeeded && chunkBeg < walls->size (); chunkBeg += chunkSize) {
+				size_t chunkEnd = std::min (chunkBeg + chunkSize, walls->size ());
+				chunk.walls.assign (walls->begin () + chunkBeg, walls->begin () + chunkEnd);
+				chunk.totalWallCount = walls->size ();
+				chunk.completedFraction = (double) chunkEnd / walls->size ();
+				succeeded = queue.Push (chunk);
+			}
+		}
+		queue.Finish (succeeded, GetElapsedMs (generationStartTime));
+	});
+
+	bool placementStarted = false;
+	bool placementFailed = false;
+	PlacementProgress progress;
+	Clock::time_point waitStartTime = Clock::now ();
+	while (!cancellationToken.IsCancelled ()) {
+		WallChunk chunk;
+		WallChunkPopResult popResult = queue.Pop (chunk, std::chrono::milliseconds (ProgressHeartbeatMs));
+		if (popResult == WallChunkPopResult::TimedOut) {
+			if (progressCallback) {
+				progressCallback (progress);
+			}
+			continue;
+		}
+		if (popResult == WallChunkPopResult::Finished || cancellationToken.IsCancelled ()) {
+			break;
+		}
+
+		PlacementChunkStats chunkStats;
+		chunkStats.wallCount = chunk.GetWallCount ();
+		chunkStats.waitMs = GetElapsedMs (waitStartTime);
+
+		Clock::time_point placementStartTime = Clock::now ();
+		if (!placementStarted) {
+			placementStarted = true;
+			if (!backend.BeginPlacement (chunk.totalWallCount)) {
+				placementFailed = true;
+				break;
+			}
+		}
+		size_t placedWallCount = 0;
+		if (mergeWalls) {
+			placedWallCount = backend.PlacePolylines (chunk.polylines);
+		} else {
+			placedWallCount = backend.PlaceWalls (chunk.walls.data (), chunk.walls.size ());
+		}
+		chunkStats.failedWallCount = chunkStats.wallCount - std::min (placedWallCount, chunkStats.wallCount);
+		chunkStats.placementMs = GetElapsedMs (placementStartTime);
+		result.chunks.push_back (chunkStats);
+		result.failedWallCount += chunkStats.failedWallCount;
+
+		progress.placedWallCount += chunkStats.wallCount - chunkStats.failedWallCount;
+		progress.placedChunkCount += 1;
+		progress.completedFraction = chunk.completedFraction;
+		if (progressCallback) {
+			progressCallback (progress);
+		}
+		waitStartTime = Clock::now ();
+	}
+
+	queue.Stop ();
+	producer.join ();
+
+	result.placedWallCount = progress.placedWallCount;
+	result.generationMs = queue.GetGenerationMs ();
+	result.totalMs = GetElapsedMs (startTime);
+	if (placementFailed) {
+		result.status = PlacementStatus::PlacementFailed;
+	} else if (cancellationToken.IsCancelled ()) {
+		result.status = PlacementStatus::Cancelled;
+	} else if (!queue.Succeeded ()) {
+		result.status = PlacementStatus::GenerationFailed;
+	} else if (result.failedWallCount > 0) {
+		result.status = (result.placedWallCount > 0 ? PlacementStatus::PartiallyFailed : PlacementStatus::PlacementFailed);
+	}
+	return result;
+}
+
+}
@@ -0,0 +1,86 @@
+#ifndef PLACEMENTPIPELINE_HPP
+#define PLACEMENTPIPELINE_HPP
+
+#include "MazeGenerator.hpp"
+#include "WallPlacement.hpp"
+#include "MazeCache.hpp"
+
+namespace MG
+{
+
+class PlacementProgress
+{
+public:
+	PlacementProgress ();
+
+	size_t	placedWallCount;
+	size_t	placedChunkCount;
+	double	completedFraction;
+};
+
+class PlacementChunkStats
+{
+public:
+	PlacementChunkStats ();
+
+	size_t	wallCount;
+	size_t	failedWallCount;
+	double	waitMs;
+	double	placementMs;
+};
+
+enum class PlacementStatus
+{
+	Completed,
+	Cancelled,
+	GenerationFailed,
+	PlacementFailed,
+	PartiallyFailed
+};
+
+class PlacementResult
+{
+public:
+	PlacementResult ();
+
+	PlacementStatus						status;
+	size_t								placedWallCount;
+	size_t								failedWallCount;
+	double								generationMs;
+	double								totalMs;
+	std::vector<PlacementChunkStats>	chunks;
+};
+
+using PlacementProgressCallback = std::function<void (const PlacementProgress& progress)>;
+
+class PlacementPipeline
+{
+public:
+	static const size_t DefaultChunkSize = 4096;
+	static const size_t MaxQueuedChunkCount = 8;
+	static const int ProgressHeartbeatMs = 100;
+
+	PlacementPipeline (int rowCount, int colCount, std::uint64_t seed, MazeAlgorithmType algorithmType, double cellSize);
+
+	void				SetChunkSize (size_t newChunkSize);
+	void				SetProgressCallback (const PlacementProgressCallback& newProgressCallback);
+	void				SetMazeCache (MazeCache* newMazeCache);
+	void				SetMergeWalls (bool newMergeWalls);
+
+	PlacementResult		Run (WallPlacementBackend& backend, CancellationToken& cancellationToken);
+
+private:
+	int							rowCount;
+	int							colCount;
+	std::uint64_t				seed;
+	MazeAlgorithmType			algorithmType;
+	double						cellSize;
+	size_t						chunkSize;
+	PlacementProgressCallback	progressCallback;
+	MazeCache*					mazeCache;
+	bool						mergeWalls;
+};
+
+}
+
+#endif
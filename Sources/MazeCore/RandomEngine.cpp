@@ -0,0 +1,82 @@
+#include "RandomEngine.hpp"
+
+namespace MG
+{
+
+static std::uint64_t RotateLeft (std::uint64_t x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+static std::uint64_t SplitMix64 (std::uint64_t& x)
+{
+	std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+std::uint64_t DeriveSeed (std::uint64_t seed, std::uint64_t streamIndex)
+{
+	std::uint64_t x = seed ^ SplitMix64 (streamIndex);
+	return SplitMix64 (x);
+}
+
+RandomEngine::~RandomEngine ()
+{
+
+}
+
+std::uint32_t RandomEngine::NextBelow (std::uint32_t bound)
+{
+	if (bound == 0) {
+		return 0;
+	}
+
+	// Lemire's multiply-shift with rejection, unbiased for every bound.
+	std::uint64_t product = (Next () >> 32) * bound;
+	std::uint32_t low = (std::uint32_t) product;
+	if (low < bound) {
+		std::uint32_t threshold = (0u - bound) % bound;
+		while (low < threshold) {
+			product = (Next () >> 32) * bound;
+			low = (std::uint32_t) product;
+		}
+	}
+	return (std::uint32_t) (product >> 32);
+}
+
+Xoshiro256Engine::Xoshiro256Engine () :
+	Xoshiro256Engine (0)
+{
+
+}
+
+Xoshiro256Engine::Xoshiro256Engine (std::uint64_t seed) :
+	state { 0, 0, 0, 0 }
+{
+	Seed (seed);
+}
+
+void Xoshiro256Engine::Seed (std::uint64_t seed)
+{
+	std::uint64_t x = seed;
+	for (std::uint64_t& s : state) {
+		s = SplitMix64 (x);
+	}
+}
+
+std::uint64_t Xoshiro256Engine::Next ()
+{
+	std::uint64_t result = RotateLeft (state[1] * 5, 7) * 9;
+	std::uint64_t t = state[1] << 17;
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+	state[2] ^= t;
+	state[3] = RotateLeft (state[3], 45);
+	return result;
+}
+
+}
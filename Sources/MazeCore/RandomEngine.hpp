@@ -0,0 +1,37 @@
+#ifndef RANDOMENGINE_HPP
+#define RANDOMENGINE_HPP
+
+#include <cstdint>
+
+namespace MG
+{
+
+std::uint64_t	DeriveSeed (std::uint64_t seed, std::uint64_t streamIndex);
+
+class RandomEngine
+{
+public:
+	virtual ~RandomEngine ();
+
+	virtual void			Seed (std::uint64_t seed) = 0;
+	virtual std::uint64_t	Next () = 0;
+
+	std::uint32_t			NextBelow (std::uint32_t bound);
+};
+
+class Xoshiro256Engine final : public RandomEngine
+{
+public:
+	Xoshiro256Engine ();
+	explicit Xoshiro256Engine (std::uint64_t seed);
+
+	virtual void			Seed (std::uint64_t seed) override;
+	virtual std::uint64_t	Next () override;
+
+private:
+	std::uint64_t	state[4];
+};
+
+}
+
+#endif
@@ -0,0 +1,41 @@
+#include "TextFile.hpp"
+
+#include <cstdio>
+
+namespace MG
+{
+
+bool ReadTextLines (const std::string& path, std::vector<std::string>& lines)
+{
+	std::FILE* file = std::fopen (path.c_str (), "rb");
+	if (file == nullptr) {
+		return false;
+	}
+	std::string content;
+	char buffer[4096];
+	size_t readSize = 0;
+	while ((readSize = std::fread (buffer, 1, sizeof (buffer), file)) > 0) {
+		content.append (buffer, readSize);
+	}
+	std::fclose (file);
+
+	size_t lineBeg = 0;
+	while (lineBeg < content.size ()) {
+		size_t lineEnd = content.find ('\n', lineBeg);
+		if (lineEnd == std::string::npos) {
+			lineEnd = content.size ();
+		}
+		std::string line = content.substr (lineBeg, lineEnd - lineBeg);
+		if (!line.empty () && line.back () == '\r') {
+			line.pop_back ();
+		}
+		lines.push_back (line);
+		lineBeg = lineEnd + 1;
+	}
+	while (!lines.empty () && lines.back ().empty ()) {
+		lines.pop_back ();
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,14 @@
+#ifndef TEXTFILE_HPP
+#define TEXTFILE_HPP
+
+#include <string>
+#include <vector>
+
+namespace MG
+{
+
+bool	ReadTextLines (const std::string& path, std::vector<std::string>& lines);
+
+}
+
+#endif
@@ -0,0 +1,152 @@
+#ifndef TOPOLOGYMAZE_HPP
+#define TOPOLOGYMAZE_HPP
+
+#include "MazeTopologies.hpp"
+#include "RandomEngine.hpp"
+#include "WallBits.hpp"
+
+#include <utility>
+
+namespace MG
+{
+
+template <typename Topology>
+class TopologyMaze
+{
+public:
+	using Geometry = typename Topology::Geometry;
+
+	TopologyMaze (int rowCount, int colCount) :
+		topology (rowCount, colCount),
+		walls ()
+	{
+		Reset ();
+	}
+
+	const Topology& GetTopology () const
+	{
+		return topology;
+	}
+
+	int GetCellCount () const
+	{
+		return topology.GetCellCount ();
+	}
+
+	int GetWallSlotCount () const
+	{
+		return topology.GetWallSlotCount ();
+	}
+
+	bool HasWall (WallId wallId) const
+	{
+		return ((walls[wallId / WallWordBits] >> (wallId % WallWordBits)) & 1) != 0;
+	}
+
+	void RemoveWall (WallId wallId)
+	{
+		walls[wallId / WallWordBits] &= ~((std::uint64_t) 1 << (wallId % WallWordBits));
+	}
+
+	size_t GetWallCount () const
+	{
+		size_t wallCount = 0;
+		for (std::uint64_t word : walls) {
+			wallCount += CountBits (word);
+		}
+		return wallCount;
+	}
+
+	void Reset ()
+	{
+		int slotCount = topology.GetWallSlotCount ();
+		walls.assign ((slotCount + WallWordBits - 1) / WallWordBits, 0);
+		CellId cellId1 = InvalidCellId;
+		CellId cellId2 = InvalidCellId;
+		for (WallId wallId = 0; wallId < slotCount; wallId++) {
+			if (topology.GetWallCells (wallId, cellId1, cellId2)) {
+				walls[wallId / WallWordBits] |= (std::uint64_t) 1 << (wallId % WallWordBits);
+			}
+		}
+	}
+
+	bool Generate (RandomEngine& randomEngine)
+	{
+		Reset ();
+		int cellCount = topology.GetCellCount ();
+		if (cellCount <= 0) {
+			return false;
+		}
+
+		std::vector<WallId> innerWalls;
+		int slotCount = topology.GetWallSlotCount ();
+		CellId cellId1 = InvalidCellId;
+		CellId cellId2 = InvalidCellId;
+		for (WallId wallId = 0; wallId < slotCount; wallId++) {
+			if (topology.GetWallCells (wallId, cellId1, cellId2) && cellId2 != InvalidCellId) {
+				innerWalls.push_back (wallId);
+			}
+		}
+		for (size_t i = innerWalls.size (); i > 1; i--) {
+			size_t j = randomEngine.NextBelow ((std::uint32_t) i);
+			std::swap (innerWalls[i - 1], innerWalls[j]);
+		}
+
+		std::vector<CellId> parents (cellCount);
+		for (CellId cellId = 0; cellId < cellCount; cellId++) {
+			parents[cellId] = cellId;
+		}
+		auto findSet = [&] (CellId cellId) {
+			while (parents[cellId] != cellId) {
+				parents[cellId] = parents[parents[cellId]];
+				cellId = parents[cellId];
+			}
+			return cellId;
+		};
+
+		int remainingSets = cellCount;
+		for (size_t i = 0; i < innerWalls.size () && remainingSets > 1; i++) {
+			topology.GetWallCells (innerWalls[i], cellId1, cellId2);
+			CellId set1 = findSet (cellId1);
+			CellId set2 = findSet (cellId2);
+			if (set1 != set2) {
+				parents[set2] = set1;
+				RemoveWall (innerWalls[i]);
+				remainingSets -= 1;
+			}
+		}
+
+		if (topology.GetEntranceWall () != InvalidWallId) {
+			RemoveWall (topology.GetEntranceWall ());
+		}
+		if (topology.GetExitWall () != InvalidWallId) {
+			RemoveWall (topology.GetExitWall ());
+		}
+		return remainingSets == 1;
+	}
+
+	template <typename PassageProcessor>
+	void EnumeratePassages (CellId cellId, const PassageProcessor& processor) const
+	{
+		topology.EnumerateCellWalls (cellId, [&] (WallId wallId, CellId neighbourId) {
+			if (neighbourId != InvalidCellId && !HasWall (wallId)) {
+				processor (neighbourId);
+			}
+		});
+	}
+
+	Geometry GetWallGeometries (double cellSize) const
+	{
+		return topology.GetWallGeometries ([&] (WallId wallId) {
+			return HasWall (wallId);
+		}, cellSize);
+	}
+
+private:
+	Topology					topology;
+	std::vector<std::uint64_t>	walls;
+};
+
+}
+
+#endif
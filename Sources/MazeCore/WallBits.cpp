@@ -0,0 +1,118 @@
+#include "WallBits.hpp"
+#include "Parallel.hpp"
+
+#include <algorithm>
+
+#if defined (_MSC_VER)
+	#include <intrin.h>
+#endif
+
+namespace MG
+{
+
+int CountTrailingZeros (std::uint64_t word)
+{
+#if defined (_MSC_VER)
+	unsigned long index = 0;
+	_BitScanForward64 (&index, word);
+	return (int) index;
+#else
+	return __builtin_ctzll (word);
+#endif
+}
+
+int CountLeadingZeros (std::uint64_t word)
+{
+#if defined (_MSC_VER)
+	unsigned long index = 0;
+	_BitScanReverse64 (&index, word);
+	return WallWordBits - 1 - (int) index;
+#else
+	return __builtin_clzll (word);
+#endif
+}
+
+int CountBits (std::uint64_t word)
+{
+#if defined (_MSC_VER)
+	return (int) __popcnt64 (word);
+#else
+	return __builtin_popcountll (word);
+#endif
+}
+
+const std::uint64_t* GetHorizontalLine (const WallBitsView& bits, int line)
+{
+	return bits.horizontalBits + (size_t) line * bits.horizontalWordsPerLine;
+}
+
+const std::uint64_t* GetVerticalLine (const WallBitsView& bits, int line)
+{
+	return bits.verticalBits + (size_t) line * bits.verticalWordsPerLine;
+}
+
+size_t CountWallRuns (const std::uint64_t* line, int wordCount)
+{
+	size_t runCount = 0;
+	std::uint64_t carry = 0;
+	for (int i = 0; i < wordCount; i++) {
+		std::uint64_t word = line[i];
+		runCount += CountBits (word & ~((word << 1) | carry));
+		carry = word >> (WallWordBits - 1);
+	}
+	return runCount;
+}
+
+std::vector<WallGeometry> ExtractWallGeometries (const WallBitsView& bits, double cellSize, int threadCount)
+{
+	int horizontalLineCount = (bits.colCount > 0 ? bits.rowCount + 1 : 0);
+	int verticalLineCount = (bits.rowCount > 0 ? bits.colCount + 1 : 0);
+	int lineCount = horizontalLineCount + verticalLineCount;
+	if (lineCount == 0) {
+		return {};
+	}
+
+	int bandCount = GetEffectiveThreadCount (threadCount, lineCount) * 4;
+	int linesPerBand = std::max ((lineCount + bandCount - 1) / bandCount, 1);
+	bandCount = (lineCount + linesPerBand - 1) / linesPerBand;
+
+	std::vector<size_t> bandOffsets (bandCount + 1, 0);
+	ParallelFor (bandCount, threadCount, [&] (int bandIndex, int) {
+		int endLine = std::min ((bandIndex + 1) * linesPerBand, lineCount);
+		size_t runCount = 0;
+		for (int lineIndex = bandIndex * linesPerBand; lineIndex < endLine; lineIndex++) {
+			if (lineIndex < horizontalLineCount) {
+				runCount += CountWallRuns (GetHorizontalLine (bits, lineIndex), bits.horizontalWordsPerLine);
+			} else {
+				runCount += CountWallRuns (GetVerticalLine (bits, lineIndex - horizontalLineCount), bits.verticalWordsPerLine);
+			}
+		}
+		bandOffsets[bandIndex + 1] = runCount;
+	});
+	for (int bandIndex = 0; bandIndex < bandCount; bandIndex++) {
+		bandOffsets[bandIndex + 1] += bandOffsets[bandIndex];
+	}
+
+	std::vector<WallGeometry> wallGeometries (bandOffsets[bandCount]);
+	ParallelFor (bandCount, threadCount, [&] (int bandIndex, int) {
+		int endLine = std::min ((bandIndex + 1) * linesPerBand, lineCount);
+		WallGeometry* output = wallGeometries.data () + bandOffsets[bandIndex];
+		for (int lineIndex = bandIndex * linesPerBand; lineIndex < endLine; lineIndex++) {
+			if (lineIndex < horizontalLineCount) {
+				double y = lineIndex * cellSize;
+				EnumerateBitRuns (GetHorizontalLine (bits, lineIndex), bits.horizontalWordsPerLine, bits.colCount, [&] (int beg, int end) {
+					*output++ = WallGeometry (beg * cellSize, y, end * cellSize, y);
+				});
+			} else {
+				double x = (lineIndex - horizontalLineCount) * cellSize;
+				EnumerateBitRuns (GetVerticalLine (bits, lineIndex - horizontalLineCount), bits.verticalWordsPerLine, bits.rowCount, [&] (int beg, int end) {
+					*output++ = WallGeometry (x, beg * cellSize, x, end * cellSize);
+				});
+			}
+		}
+	});
+
+	return wallGeometries;
+}
+
+}
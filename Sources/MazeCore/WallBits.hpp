@@ -0,0 +1,48 @@
+#ifndef WALLBITS_HPP
+#define WALLBITS_HPP
+
+#include "MazeGenerator.hpp"
+
+namespace MG
+{
+
+int							CountTrailingZeros (std::uint64_t word);
+int							CountLeadingZeros (std::uint64_t word);
+int							CountBits (std::uint64_t word);
+
+const std::uint64_t*		GetHorizontalLine (const WallBitsView& bits, int line);
+const std::uint64_t*		GetVerticalLine (const WallBitsView& bits, int line);
+
+size_t						CountWallRuns (const std::uint64_t* line, int wordCount);
+std::vector<WallGeometry>	ExtractWallGeometries (const WallBitsView& bits, double cellSize, int threadCount);
+
+template <typename RunProcessor>
+void EnumerateBitRuns (const std::uint64_t* line, int wordCount, int lineLength, const RunProcessor& processor)
+{
+	int runBeg = -1;
+	for (int i = 0; i < wordCount; i++) {
+		std::uint64_t word = line[i];
+		int wordBeg = i * WallWordBits;
+		int position = 0;
+		while (position < WallWordBits) {
+			std::uint64_t rest = (runBeg < 0 ? word : ~word) >> position;
+			if (rest == 0) {
+				break;
+			}
+			position += CountTrailingZeros (rest);
+			if (runBeg < 0) {
+				runBeg = wordBeg + position;
+			} else {
+				processor (runBeg, wordBeg + position);
+				runBeg = -1;
+			}
+		}
+	}
+	if (runBeg >= 0) {
+		processor (runBeg, lineLength);
+	}
+}
+
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef WALLCOLLECTOR_HPP
+#define WALLCOLLECTOR_HPP
+
+#include "MazeGenerator.hpp"
+
+#include <cmath>
+
+namespace MG
+{
+
+static const double Eps = 0.00005;
+
+class WallCollector
+{
+public:
+	enum class Direction
+	{
+		Horizontal,
+		Vertical
+	};
+
+	WallCollector (std::vector<WallGeometry>& wallGeometries, Direction direction, double elevation) :
+		wallGeometries (wallGeometries),
+		direction (direction),
+		elevation (elevation),
+		begPosition (0.0),
+		endPosition (0.0),
+		hasWall (false)
+	{
+
+	}
+
+	void AddWall (double beg, double end)
+	{
+		if (hasWall && std::fabs (endPosition - beg) > Eps) {
+			Flush ();
+		}
+		if (!hasWall) {
+			begPosition = beg;
+		}
+		endPosition = end;
+		hasWall = true;
+	}
+
+	void Flush ()
+	{
+		if (hasWall) {
+			if (direction == Direction::Horizontal) {
+				wallGeometries.push_back (WallGeometry (begPosition, elevation, endPosition, elevation));
+			} else if (direction == Direction::Vertical) {
+				wallGeometries.push_back (WallGeometry (elevation, begPosition, elevation, endPosition));
+			}
+			hasWall = false;
+		}
+	}
+
+private:
+	std::vector<WallGeometry>&	wallGeometries;
+	Direction					direction;
+	double						elevation;
+	double						begPosition;
+	double						endPosition;
+	bool						hasWall;
+};
+
+}
+
+#endif
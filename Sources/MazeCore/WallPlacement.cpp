@@ -0,0 +1,34 @@
+#include "WallPlacement.hpp"
+
+#include <algorithm>
+
+namespace MG
+{
+
+WallPlacementBackend::~WallPlacementBackend ()
+{
+
+}
+
+WallPlacer::WallPlacer (WallPlacementBackend& backend, size_t batchSize) :
+	backend (backend),
+	batchSize (batchSize > 0 ? batchSize : DefaultBatchSize)
+{
+
+}
+
+bool WallPlacer::PlaceWalls (const std::vector<WallGeometry>& walls)
+{
+	if (!backend.BeginPlacement (walls.size ())) {
+		return false;
+	}
+	for (size_t batchBeg = 0; batchBeg < walls.size (); batchBeg += batchSize) {
+		size_t batchWallCount = std::min (batchSize, walls.size () - batchBeg);
+		if (backend.PlaceWalls (walls.data () + batchBeg, batchWallCount) != batchWallCount) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}
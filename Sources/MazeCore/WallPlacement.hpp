@@ -0,0 +1,36 @@
+#ifndef WALLPLACEMENT_HPP
+#define WALLPLACEMENT_HPP
+
+#include "MazeGenerator.hpp"
+#include "WallPolylines.hpp"
+
+namespace MG
+{
+
+class WallPlacementBackend
+{
+public:
+	virtual ~WallPlacementBackend ();
+
+	virtual bool	BeginPlacement (size_t wallCount) = 0;
+	virtual size_t	PlaceWalls (const WallGeometry* walls, size_t wallCount) = 0;
+	virtual size_t	PlacePolylines (const WallPolylines& polylines) = 0;
+};
+
+class WallPlacer
+{
+public:
+	static const size_t DefaultBatchSize = 512;
+
+	WallPlacer (WallPlacementBackend& backend, size_t batchSize = DefaultBatchSize);
+
+	bool	PlaceWalls (const std::vector<WallGeometry>& walls);
+
+private:
+	WallPlacementBackend&	backend;
+	size_t					batchSize;
+};
+
+}
+
+#endif
@@ -0,0 +1,213 @@
+#include "WallPolylines.hpp"
+#include "WallBits.hpp"
+
+#include <cmath>
+
+namespace MG
+{
+
+static const unsigned char EdgeRight = 1;
+static const unsigned char EdgeLeft = 2;
+static const unsigned char EdgeDown = 4;
+static const unsigned char EdgeUp = 8;
+static const unsigned char EdgeOrder[] = { EdgeRight, EdgeDown, EdgeLeft, EdgeUp };
+
+static unsigned char GetOppositeEdge (unsigned char edge)
+{
+	switch (edge) {
+		case EdgeRight:	return EdgeLeft;
+		case EdgeLeft:	return EdgeRight;
+		case EdgeDown:	return EdgeUp;
+		default:		return EdgeDown;
+	}
+}
+
+static int GetEdgeCount (unsigned char edges)
+{
+	return CountBits (edges);
+}
+
+template <typename BitProcessor>
+static void EnumerateBits (const std::uint64_t* line, int wordCount, const BitProcessor& processor)
+{
+	for (int i = 0; i < wordCount; i++) {
+		std::uint64_t word = line[i];
+		while (word != 0) {
+			processor (i * WallWordBits + CountTrailingZeros (word));
+			word &= word - 1;
+		}
+	}
+}
+
+WallPoint::WallPoint () :
+	x (0.0),
+	y (0.0)
+{
+
+}
+
+WallPoint::WallPoint (double x, double y) :
+	x (x),
+	y (y)
+{
+
+}
+
+WallPolylines::WallPolylines () :
+	points (),
+	polylineEnds ()
+{
+
+}
+
+size_t WallPolylines::GetPolylineCount () const
+{
+	return polylineEnds.size ();
+}
+
+size_t WallPolylines::GetPointCount (size_t polylineIndex) const
+{
+	size_t polylineBeg = (polylineIndex == 0 ? 0 : polylineEnds[polylineIndex - 1]);
+	return polylineEnds[polylineIndex] - polylineBeg;
+}
+
+const WallPoint* WallPolylines::GetPoints (size_t polylineIndex) const
+{
+	size_t polylineBeg = (polylineIndex == 0 ? 0 : polylineEnds[polylineIndex - 1]);
+	return points.data () + polylineBeg;
+}
+
+size_t WallPolylines::GetSegmentCount () const
+{
+	return points.size () - polylineEnds.size ();
+}
+
+WallPolylines TraceWallPolylines (const WallBitsView& bits, double cellSize)
+{
+	WallPolylines polylines;
+	if (bits.rowCount <= 0 || bits.colCount <= 0) {
+		return polylines;
+	}
+
+	int pointCols = bits.colCount + 1;
+	size_t pointCount = (size_t) (bits.rowCount + 1) * pointCols;
+	std::vector<unsigned char> edges (pointCount, 0);
+	for (int row = 0; row <= bits.rowCount; row++) {
+		size_t rowOffset = (size_t) row * pointCols;
+		EnumerateBits (GetHorizontalLine (bits, row), bits.horizontalWordsPerLine, [&] (int col) {
+			edges[rowOffset + col] |= EdgeRight;
+			edges[rowOffset + col + 1] |= EdgeLeft;
+		});
+	}
+	for (int col = 0; col <= bits.colCount; col++) {
+		EnumerateBits (GetVerticalLine (bits, col), bits.verticalWordsPerLine, [&] (int row) {
+			edges[(size_t) row * pointCols + col] |= EdgeDown;
+			edges[(size_t) (row + 1) * pointCols + col] |= EdgeUp;
+		});
+	}
+
+	std::vector<std::uint32_t> visitedBy (pointCount, 0);
+	std::uint32_t polylineId = 0;
+	auto GetPoint = [&] (size_t pointIndex) {
+		return WallPoint ((pointIndex % pointCols) * cellSize, (pointIndex / pointCols) * cellSize);
+	};
+	auto GetNextPoint = [&] (size_t pointIndex, unsigned char edge) {
+		switch (edge) {
+			case EdgeRight:	return pointIndex + 1;
+			case EdgeLeft:	return pointIndex - 1;
+			case EdgeDown:	return pointIndex + pointCols;
+			default:		return pointIndex - pointCols;
+		}
+	};
+	auto TracePolyline = [&] (size_t startIndex) {
+		polylineId += 1;
+		polylines.points.push_back (GetPoint (startIndex));
+		size_t current = startIndex;
+		unsigned char lastEdge = 0;
+		while (true) {
+			visitedBy[current] = polylineId;
+			auto IsAvailable = [&] (unsigned char candidate) {
+				return (edges[current] & candidate) != 0 && visitedBy[GetNextPoint (current, candidate)] != polylineId;
+			};
+			unsigned char edge = 0;
+			if (lastEdge != 0 && IsAvailable (lastEdge)) {
+				edge = lastEdge;
+			} else {
+				for (unsigned char candidate : EdgeOrder) {
+					if (IsAvailable (candidate)) {
+						edge = candidate;
+						break;
+					}
+				}
+			}
+			if (edge == 0) {
+				break;
+			}
+			size_t next = GetNextPoint (current, edge);
+			if (lastEdge != 0 && edge != lastEdge) {
+				polylines.points.push_back (GetPoint (current));
+			}
+			edges[current] &= ~edge;
+			edges[next] &= ~GetOppositeEdge (edge);
+			current = next;
+			lastEdge = edge;
+		}
+		polylines.points.push_back (GetPoint (current));
+		polylines.polylineEnds.push_back (polylines.points.size ());
+	};
+
+	for (size_t pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+		while (GetEdgeCount (edges[pointIndex]) % 2 == 1) {
+			TracePolyline (pointIndex);
+		}
+	}
+	for (size_t pointIndex = 0; pointIndex < pointCount; pointIndex++) {
+		while (edges[pointIndex] != 0) {
+			TracePolyline (pointIndex);
+		}
+	}
+
+	return polylines;
+}
+
+std::vector<WallPoint> GetWallPolylineOutline (const WallPoint* points, size_t pointCount, double thickness)
+{
+	std::vector<WallPoint> outline;
+	if (pointCount < 2) {
+		return outline;
+	}
+
+	double halfThickness = thickness / 2.0;
+	std::vector<WallPoint> directions;
+	for (size_t i = 0; i + 1 < pointCount; i++) {
+		double dx = points[i + 1].x - points[i].x;
+		double dy = points[i + 1].y - points[i].y;
+		double length = std::sqrt (dx * dx + dy * dy);
+		directions.push_back (WallPoint (dx / length, dy / length));
+	}
+
+	auto GetOffsetPoint = [&] (size_t i, double side) {
+		const WallPoint& point = points[i];
+		if (i == 0) {
+			const WallPoint& dir = directions.front ();
+			return WallPoint (point.x - dir.x * halfThickness - dir.y * side, point.y - dir.y * halfThickness + dir.x * side);
+		}
+		if (i == pointCount - 1) {
+			const WallPoint& dir = directions.back ();
+			return WallPoint (point.x + dir.x * halfThickness - dir.y * side, point.y + dir.y * halfThickness + dir.x * side);
+		}
+		const WallPoint& prevDir = directions[i - 1];
+		const WallPoint& nextDir = directions[i];
+		return WallPoint (point.x - (prevDir.y + nextDir.y) * side, point.y + (prevDir.x + nextDir.x) * side);
+	};
+
+	for (size_t i = 0; i < pointCount; i++) {
+		outline.push_back (GetOffsetPoint (i, halfThickness));
+	}
+	for (size_t i = pointCount; i > 0; i--) {
+		outline.push_back (GetOffsetPoint (i - 1, -halfThickness));
+	}
+	return outline;
+}
+
+}
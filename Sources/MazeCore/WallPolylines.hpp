@@ -0,0 +1,38 @@
+#ifndef WALLPOLYLINES_HPP
+#define WALLPOLYLINES_HPP
+
+#include "MazeGenerator.hpp"
+
+namespace MG
+{
+
+class WallPoint
+{
+public:
+	WallPoint ();
+	WallPoint (double x, double y);
+
+	double x;
+	double y;
+};
+
+class WallPolylines
+{
+public:
+	WallPolylines ();
+
+	size_t				GetPolylineCount () const;
+	size_t				GetPointCount (size_t polylineIndex) const;
+	const WallPoint*	GetPoints (size_t polylineIndex) const;
+	size_t				GetSegmentCount () const;
+
+	std::vector<WallPoint>	points;
+	std::vector<size_t>		polylineEnds;
+};
+
+WallPolylines			TraceWallPolylines (const WallBitsView& bits, double cellSize);
+std::vector<WallPoint>	GetWallPolylineOutline (const WallPoint* points, size_t pointCount, double thickness);
+
+}
+
+#endif
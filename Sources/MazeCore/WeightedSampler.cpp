@@ -0,0 +1,84 @@
+#include "WeightedSampler.hpp"
+
+namespace MG
+{
+
+WeightedSampler::WeightedSampler (MemoryArena* arena) :
+	weights (ArenaAllocator<std::uint32_t> (arena)),
+	prefixTree (ArenaAllocator<std::uint64_t> (arena)),
+	totalWeight (0),
+	highestStep (0)
+{
+
+}
+
+void WeightedSampler::Reset (int itemCount)
+{
+	int count = (itemCount > 0 ? itemCount : 0);
+	weights.assign (count, 0);
+	prefixTree.assign (count + 1, 0);
+	totalWeight = 0;
+	highestStep = 1;
+	while (highestStep * 2 <= count) {
+		highestStep *= 2;
+	}
+}
+
+int WeightedSampler::GetItemCount () const
+{
+	return (int) weights.size ();
+}
+
+std::uint64_t WeightedSampler::GetTotalWeight () const
+{
+	return totalWeight;
+}
+
+std::uint32_t WeightedSampler::GetWeight (int index) const
+{
+	return weights[index];
+}
+
+void WeightedSampler::SetWeight (int index, std::uint32_t weight)
+{
+	std::uint32_t oldWeight = weights[index];
+	if (oldWeight == weight) {
+		return;
+	}
+	weights[index] = weight;
+	totalWeight = totalWeight - oldWeight + weight;
+
+	// The tree is updated with unsigned wrap-around, so a decrease is the same addition.
+	std::uint64_t delta = (std::uint64_t) weight - oldWeight;
+	int count = (int) weights.size ();
+	for (int treeIndex = index + 1; treeIndex <= count; treeIndex += treeIndex & -treeIndex) {
+		prefixTree[treeIndex] += delta;
+	}
+}
+
+int WeightedSampler::Sample (RandomEngine& randomEngine) const
+{
+	if (totalWeight == 0) {
+		return -1;
+	}
+
+	std::uint64_t threshold = (0 - totalWeight) % totalWeight;
+	std::uint64_t random = randomEngine.Next ();
+	while (random < threshold) {
+		random = randomEngine.Next ();
+	}
+	std::uint64_t target = random % totalWeight;
+
+	int count = (int) weights.size ();
+	int position = 0;
+	for (int step = highestStep; step > 0; step /= 2) {
+		int nextPosition = position + step;
+		if (nextPosition <= count && prefixTree[nextPosition] <= target) {
+			target -= prefixTree[nextPosition];
+			position = nextPosition;
+		}
+	}
+	return position;
+}
+
+}
@@ -0,0 +1,33 @@
+#ifndef WEIGHTEDSAMPLER_HPP
+#define WEIGHTEDSAMPLER_HPP
+
+#include "MemoryArena.hpp"
+#include "RandomEngine.hpp"
+
+namespace MG
+{
+
+class WeightedSampler
+{
+public:
+	explicit WeightedSampler (MemoryArena* arena = nullptr);
+
+	void			Reset (int itemCount);
+
+	int				GetItemCount () const;
+	std::uint64_t	GetTotalWeight () const;
+	std::uint32_t	GetWeight (int index) const;
+	void			SetWeight (int index, std::uint32_t weight);
+
+	int				Sample (RandomEngine& randomEngine) const;
+
+private:
+	ArenaVector<std::uint32_t>	weights;
+	ArenaVector<std::uint64_t>	prefixTree;
+	std::uint64_t				totalWeight;
+	int							highestStep;
+};
+
+}
+
+#endif
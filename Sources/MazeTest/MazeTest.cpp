@@ -0,0 +1,295 @@
+#include "MazeGenerator.hpp"
+#include "MazeAlgorithms.hpp"
+#include "CellMask.hpp"
+#include "MazeFile.hpp"
+#include "MazeDistances.hpp"
+#include "MazeRegion.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+using TestFunction = std::function<bool ()>;
+
+class Test
+{
+public:
+	Test (const std::string& name, const TestFunction& function);
+
+	std::string		name;
+	TestFunction	function;
+};
+
+Test::Test (const std::string& name, const TestFunction& function) :
+	name (name),
+	function (function)
+{
+
+}
+
+static bool ReadFileWords (const std::string& path, std::vector<std::uint64_t>& words)
+{
+	std::FILE* file = std::fopen (path.c_str (), "rb");
+	if (file == nullptr) {
+		return false;
+	}
+	std::fseek (file, 0, SEEK_END);
+	long size = std::ftell (file);
+	std::fseek (file, 0, SEEK_SET);
+	words.assign ((size_t) size / sizeof (std::uint64_t), 0);
+	bool succeeded = (size % sizeof (std::uint64_t) == 0) && std::fread (words.data (), sizeof (std::uint64_t), words.size (), file) == words.size ();
+	std::fclose (file);
+	return succeeded;
+}
+
+static bool WriteFileWords (const std::string& path, const std::vector<std::uint64_t>& words)
+{
+	std::FILE* file = std::fopen (path.c_str (), "wb");
+	if (file == nullptr) {
+		return false;
+	}
+	bool succeeded = std::fwrite (words.data (), sizeof (std::uint64_t), words.size (), file) == words.size ();
+	return (std::fclose (file) == 0) && succeeded;
+}
+
+static bool SetMazeFileBit (const std::string& path, bool horizontal, int line, int position)
+{
+	MG::MappedMazeFile mappedFile;
+	if (!mappedFile.Open (path, false)) {
+		return false;
+	}
+	MG::WallBitsView bits = mappedFile.GetWallBits ();
+	size_t headerWordCount = sizeof (MG::MazeFileHeader) / sizeof (std::uint64_t);
+	size_t checksumWordIndex = offsetof (MG::MazeFileHeader, checksum) / sizeof (std::uint64_t);
+	size_t horizontalWordCount = (size_t) mappedFile.GetHeader ().horizontalWordCount;
+	mappedFile.Close ();
+
+	std::vector<std::uint64_t> words;
+	if (!ReadFileWords (path, words)) {
+		return false;
+	}
+	std::uint64_t* wallWords = words.data () + headerWordCount;
+	bits.horizontalBits = wallWords;
+	bits.verticalBits = wallWords + horizontalWordCount;
+
+	std::uint64_t* lineWords = (horizontal ? wallWords + (size_t) line * bits.horizontalWordsPerLine : wallWords + horizontalWordCount + (size_t) line * bits.verticalWordsPerLine);
+	lineWords[position / MG::WallWordBits] |= (std::uint64_t) 1 << (position % MG::WallWordBits);
+	words[checksumWordIndex] = MG::ComputeWallBitsChecksum (bits);
+	return WriteFileWords (path, words);
+}
+
+static bool TestMazeFileRoundTrip ()
+{
+	MG::MazeGenerator generator (37, 70, 5, MG::MazeAlgorithmType::Kruskal);
+	std::string path = "maze-test-roundtrip.mgwb";
+	if (!generator.Generate () || !MG::WriteMazeFile (path, generator.GetMaze ())) {
+		return false;
+	}
+	MG::Maze maze;
+	bool succeeded = MG::ReadMazeFile (path, maze) && maze.GetWallGeometries (1.0).size () == generator.GetMaze ().GetWallGeometries (1.0).size ();
+	std::remove (path.c_str ());
+	return succeeded;
+}
+
+static bool TestMazeFileCorruptedTail ()
+{
+	MG::MazeGenerator generator (10, 10, 1);
+	std::string path = "maze-test-tail.mgwb";
+	bool succeeded = generator.Generate ();
+	for (bool horizontal : { true, false }) {
+		MG::MappedMazeFile mappedFile;
+		succeeded = succeeded &&
+			MG::WriteMazeFile (path, generator.GetMaze ()) &&
+			mappedFile.Open (path, true);
+		mappedFile.Close ();
+		succeeded = succeeded &&
+			SetMazeFileBit (path, horizontal, 3, 12) &&
+			!mappedFile.Open (path, true) &&
+			!mappedFile.Open (path, false);
+	}
+	std::remove (path.c_str ());
+	return succeeded;
+}
+
+static bool TestMaskedGenerationCancel ()
+{
+	MG::CellMask cellMask (300, 300, true);
+	cellMask.SetCellActive (150, 150, false);
+	MG::CancellationToken cancellationToken;
+	cancellationToken.Cancel ();
+
+	bool succeeded = true;
+	for (MG::MazeAlgorithmType algorithmType : { MG::MazeAlgorithmType::Prim, MG::MazeAlgorithmType::Kruskal, MG::MazeAlgorithmType::RecursiveBacktracker, MG::MazeAlgorithmType::Wilson }) {
+		MG::MazeGenerator cancelledGenerator (cellMask, 7, algorithmType);
+		cancelledGenerator.SetCancellationToken (&cancellationToken);
+		MG::MazeGenerator generator (cellMask, 7, algorithmType);
+		if (cancelledGenerator.Generate () || !generator.Generate ()) {
+			std::fprintf (stderr, "  %s\n", MG::GetMazeAlgorithmName (algorithmType));
+			succeeded = false;
+		}
+	}
+	return succeeded;
+}
+
+static bool TestReadCellMaskFile ()
+{
+	std::string path = "maze-test-mask.txt";
+	std::FILE* file = std::fopen (path.c_str (), "wb");
+	if (file == nullptr) {
+		return false;
+	}
+	std::fputs ("..#\r\n.\r\n...\n\n", file);
+	std::fclose (file);
+
+	MG::CellMask cellMask;
+	bool succeeded = MG::ReadCellMaskFile (path, cellMask) &&
+		cellMask.GetRowCount () == 3 &&
+		cellMask.GetColCount () == 3 &&
+		cellMask.GetActiveCellCount () == 6 &&
+		!cellMask.IsCellActive (0, 2) &&
+		!cellMask.IsCellActive (1, 1);
+	std::remove (path.c_str ());
+	return succeeded && !MG::ReadCellMaskFile (path, cellMask);
+}
+
+using WallSegment = std::array<double, 4>;
+
+static bool IsPerfectMaze (const MG::Maze& maze)
+{
+	int rowCount = maze.GetRowCount ();
+	int colCount = maze.GetColCount ();
+	int passageCount = 0;
+	for (int row = 0; row < rowCount; row++) {
+		for (int col = 0; col < colCount; col++) {
+			if (col + 1 < colCount && !maze.HasWall (maze.ComputeWallId (row, col, MG::Direction::Right))) {
+				passageCount += 1;
+			}
+			if (row + 1 < rowCount && !maze.HasWall (maze.ComputeWallId (row, col, MG::Direction::Bottom))) {
+				passageCount += 1;
+			}
+		}
+	}
+	MG::DistanceField field = MG::ComputeDistanceField (maze.GetWallBits (), 0, 1);
+	return passageCount == maze.GetCellCount () - 1 && field.reachedCellCount == (size_t) maze.GetCellCount ();
+}
+
+static WallSegment GetWallSegment (const MG::WallGeometry& wall)
+{
+	WallSegment segment = { wall.begX, wall.begY, wall.endX, wall.endY };
+	if (std::make_pair (segment[2], segment[3]) < std::make_pair (segment[0], segment[1])) {
+		segment = { wall.endX, wall.endY, wall.begX, wall.begY };
+	}
+	return segment;
+}
+
+static std::vector<WallSegment> GetWallSegments (const std::vector<MG::WallGeometry>& walls)
+{
+	std::vector<WallSegment> segments;
+	for (const MG::WallGeometry& wall : walls) {
+		segments.push_back (GetWallSegment (wall));
+	}
+	std::sort (segments.begin (), segments.end ());
+	return segments;
+}
+
+static bool IsMatchingWallDiff (const MG::Maze& oldMaze, const MG::Maze& newMaze, const MG::MazeWallDiff& diff)
+{
+	std::vector<MG::WallId> changedWallIds;
+	for (MG::WallId wallId = 0; wallId < newMaze.GetWallSlotCount (); wallId++) {
+		if (oldMaze.HasWall (wallId) != newMaze.HasWall (wallId)) {
+			changedWallIds.push_back (wallId);
+		}
+	}
+	if (changedWallIds != diff.changedWallIds) {
+		return false;
+	}
+
+	std::vector<WallSegment> segments = GetWallSegments (oldMaze.GetWallGeometries (1.0));
+	for (const MG::WallGeometry& wall : diff.removedWalls) {
+		auto found = std::lower_bound (segments.begin (), segments.end (), GetWallSegment (wall));
+		if (found == segments.end () || *found != GetWallSegment (wall)) {
+			return false;
+		}
+		segments.erase (found);
+	}
+	for (const MG::WallGeometry& wall : diff.addedWalls) {
+		segments.insert (std::upper_bound (segments.begin (), segments.end (), GetWallSegment (wall)), GetWallSegment (wall));
+	}
+	return segments == GetWallSegments (newMaze.GetWallGeometries (1.0));
+}
+
+static MG::MazeRegion CreateRandomRegion (const MG::Maze& maze, MG::RandomEngine& randomEngine, bool masked)
+{
+	int rowCount = 1 + (int) randomEngine.NextBelow ((std::uint32_t) maze.GetRowCount ());
+	int colCount = 1 + (int) randomEngine.NextBelow ((std::uint32_t) maze.GetColCount ());
+	int begRow = (int) randomEngine.NextBelow ((std::uint32_t) (maze.GetRowCount () - rowCount + 1));
+	int begCol = (int) randomEngine.NextBelow ((std::uint32_t) (maze.GetColCount () - colCount + 1));
+	MG::MazeRegion region (begRow, begCol, rowCount, colCount);
+	if (masked) {
+		region.cellMask.Reset (rowCount, colCount, false);
+		for (int row = 0; row < rowCount; row++) {
+			for (int col = 0; col < colCount; col++) {
+				region.cellMask.SetCellActive (row, col, randomEngine.NextBelow (4) != 0);
+			}
+		}
+	}
+	return region;
+}
+
+static bool TestRegenerateMazeRegion ()
+{
+	MG::Xoshiro256Engine randomEngine (11);
+	bool succeeded = true;
+	for (MG::MazeAlgorithmType algorithmType : MG::GetAllMazeAlgorithmTypes ()) {
+		for (std::uint64_t seed = 1; seed <= 4; seed++) {
+			MG::MazeGenerator generator (23 + (int) seed * 7, 41 - (int) seed * 5, seed, algorithmType);
+			if (!generator.Generate ()) {
+				return false;
+			}
+			MG::Maze maze = generator.GetMaze ();
+			for (int edit = 0; edit < 24; edit++) {
+				MG::MazeRegion region = CreateRandomRegion (maze, randomEngine, edit % 2 == 1);
+				MG::Maze oldMaze = maze;
+				MG::MazeWallDiff diff;
+				if (!MG::RegenerateMazeRegion (maze, region, randomEngine, 1.0, diff) || !IsPerfectMaze (maze) || !IsMatchingWallDiff (oldMaze, maze, diff)) {
+					std::fprintf (stderr, "  %s seed %d edit %d\n", MG::GetMazeAlgorithmName (algorithmType), (int) seed, edit);
+					succeeded = false;
+					break;
+				}
+			}
+		}
+	}
+	return succeeded;
+}
+
+static std::vector<Test> CreateTests ()
+{
+	std::vector<Test> tests;
+	tests.push_back (Test ("MazeFile/roundtrip", TestMazeFileRoundTrip));
+	tests.push_back (Test ("MazeFile/corrupted-tail", TestMazeFileCorruptedTail));
+	tests.push_back (Test ("MazeGenerator/masked-cancel", TestMaskedGenerationCancel));
+	tests.push_back (Test ("CellMask/read-file", TestReadCellMaskFile));
+	tests.push_back (Test ("MazeRegion/regenerate", TestRegenerateMazeRegion));
+	return tests;
+}
+
+int main (int argc, char** argv)
+{
+	std::string filter = (argc > 1 ? argv[1] : "");
+	int failedCount = 0;
+	for (const Test& test : CreateTests ()) {
+		if (!filter.empty () && test.name.find (filter) == std::string::npos) {
+			continue;
+		}
+		bool passed = test.function ();
+		std::fprintf (stderr, "%-48s %s\n", test.name.c_str (), passed ? "passed" : "FAILED");
+		if (!passed) {
+			failedCount += 1;
+		}
+	}
+	return failedCount > 0 ? 1 : 0;
+}